@@ -1,6 +1,13 @@
 #ifdef CPU_CPP
 
 void CPU::serialize(serializer &s) {
+  //coprocessors are serialized after the S-CPU; with the timeline at zero, their timestamps are relative clocks
+  if(s.mode() == serializer::Save) coprocessor_normalize();
+  if(s.mode() == serializer::Load) {
+    coprocessor_time = 0;
+    coprocessor_wake = INT64_MIN;
+  }
+
   Processor::serialize(s);
   CPUcore::core_serialize(s);
   PPUcounter::serialize(s);
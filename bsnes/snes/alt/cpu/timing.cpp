@@ -64,7 +64,10 @@ void CPU::scanline() {
   synchronize_coprocessor();
   system.scanline();
 
-  if(vcounter() == 0) hdma_init();
+  if(vcounter() == 0) {
+    hdma_init();
+    coprocessor_normalize();
+  }
 
   queue.enqueue(534, QueueEvent::DramRefresh);
 
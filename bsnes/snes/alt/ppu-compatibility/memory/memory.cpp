@@ -6,6 +6,25 @@ void PPU::latch_counters() {
   regs.counters_latched = true;
 }
 
+//the *_store() helpers stamp changed memory for the line cache (see render/linecache.cpp)
+inline void PPU::vram_store(uint16 addr, uint8 data) {
+  if(memory::vram[addr] == data) return;
+  memory::vram[addr] = data;
+  vram_serial[addr >> 10] = render_serial;
+}
+
+inline void PPU::oam_store(uint16 addr, uint8 data) {
+  if(memory::oam[addr] == data) return;
+  memory::oam[addr] = data;
+  oam_serial = render_serial;
+}
+
+inline void PPU::cgram_store(uint16 addr, uint8 data) {
+  if(memory::cgram[addr] == data) return;
+  memory::cgram[addr] = data;
+  cgram_serial = render_serial;
+}
+
 uint16 PPU::get_vram_address() {
   uint16 addr = regs.vram_addr;
   switch(regs.vram_mapping) {
@@ -31,13 +50,13 @@ uint8 PPU::vram_mmio_read(uint16 addr) {
 
 void PPU::vram_mmio_write(uint16 addr, uint8 data) {
   if(regs.display_disabled == true) {
-    memory::vram[addr] = data;
+    vram_store(addr, data);
   } else {
     uint16 v = cpu.vcounter_past(6);
     if(v >= (!overscan() ? 225 : 240)) {
-      memory::vram[addr] = data;
+      vram_store(addr, data);
     } else if(v == 0 && cpu.hcounter_past(6) == 0) {
-      memory::vram[addr] = cpu.regs.mdr;
+      vram_store(addr, cpu.regs.mdr);
     }
   }
 }
@@ -67,14 +86,14 @@ void PPU::oam_mmio_write(uint16 addr, uint8 data) {
   sprite_list_valid = false;
 
   if(regs.display_disabled == true) {
-    memory::oam[addr] = data;
+    oam_store(addr, data);
     update_sprite_list(addr, data);
   } else {
     if(cpu.vcounter() < (!overscan() ? 225 : 240)) {
-      memory::oam[regs.ioamaddr] = data;
+      oam_store(regs.ioamaddr, data);
       update_sprite_list(regs.ioamaddr, data);
     } else {
-      memory::oam[addr] = data;
+      oam_store(addr, data);
       update_sprite_list(addr, data);
     }
   }
@@ -105,14 +124,14 @@ void PPU::cgram_mmio_write(uint16 addr, uint8 data) {
   if(addr & 1) data &= 0x7f;
 
   if(1 || regs.display_disabled == true) {
-    memory::cgram[addr] = data;
+    cgram_store(addr, data);
   } else {
     uint16 v = cpu.vcounter();
     uint16 h = cpu.hcounter();
     if(v < (!overscan() ? 225 : 240) && h >= 128 && h < 1096) {
-      memory::cgram[regs.icgramaddr] = data & 0x7f;
+      cgram_store(regs.icgramaddr, data & 0x7f);
     } else {
-      memory::cgram[addr] = data;
+      cgram_store(addr, data);
     }
   }
 }
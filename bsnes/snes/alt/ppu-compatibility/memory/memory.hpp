@@ -1,4 +1,7 @@
 uint16 get_vram_address();
+inline void vram_store(uint16 addr, uint8 data);
+inline void oam_store(uint16 addr, uint8 data);
+inline void cgram_store(uint16 addr, uint8 data);
 
 debugvirtual uint8 vram_mmio_read(uint16 addr);
 debugvirtual void vram_mmio_write(uint16 addr, uint8 data);
@@ -1,5 +1,9 @@
 #include <snes.hpp>
 
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+
 #define PPU_CPP
 namespace SNES {
 
@@ -106,7 +110,6 @@ void PPU::scanline() {
 void PPU::render_scanline() {
   if(line >= 1 && line < (!overscan() ? 225 : 240)) {
     if(framecounter) return;
-    render_line_oam_rto();
     render_line();
   }
 }
@@ -130,6 +133,7 @@ void PPU::power() {
   for(unsigned i = 0; i < memory::oam.size();   i++) memory::oam[i]   = 0x00;
   for(unsigned i = 0; i < memory::cgram.size(); i++) memory::cgram[i] = 0x00;
   flush_tiledata_cache();
+  line_cache_flush();
 
   region = (system.region() == System::Region::NTSC ? 0 : 1);  //0 = NTSC, 1 = PAL
 
@@ -396,6 +400,7 @@ PPU::PPU() {
   output = surface + 16 * 512;
 
   alloc_tiledata_cache();
+  line_cache_init();
 
   for(unsigned l = 0; l < 16; l++) {
     for(unsigned i = 0; i < 4096; i++) {
@@ -45,6 +45,8 @@ public:
     uint16 m7a, m7b, m7c, m7d, m7x, m7y;
   } cache;
 
+  #include "render/linecache.hpp"
+
   alwaysinline bool interlace() const { return display.interlace; }
   alwaysinline bool overscan()  const { return display.overscan;  }
   alwaysinline bool hires()     const { return (regs.pseudo_hires || regs.bg_mode == 5 || regs.bg_mode == 6); }
@@ -14,88 +14,91 @@ inline uint16 PPU::get_direct_color(uint8 p, uint8 t) {
     ((t >> 6) << 13) | ((p >> 2) << 12);
 }
 
-inline uint16 PPU::get_pixel_normal(uint32 x) {
-  pixel_t &p = pixel_cache[x];
-  uint16 src_main, src_sub;
-  uint8  bg_sub;
-  src_main = p.src_main;
-
-  if(!regs.addsub_mode) {
-    bg_sub  = BACK;
-    src_sub = regs.color_rgb;
-  } else {
-    bg_sub  = p.bg_sub;
-    src_sub = p.src_sub;
-  }
-
-  if(!window[COL].main[x]) {
-    if(!window[COL].sub[x]) {
-      return 0x0000;
-    }
-    src_main = 0x0000;
+//resolves color window clipping and color math enables for one screen into compose,
+//so that compose_math() can run the arithmetic on whole vectors without branching.
+//swap = true composites the subscreen as the main source, for the even pixels of hires lines.
+inline void PPU::compose_operands(bool swap) {
+  const uint8 *wmain = window[COL].main;
+  const uint8 *wsub  = window[COL].sub;
+  const bool addsub_mode = regs.addsub_mode;
+  const bool color_halve = regs.color_halve;
+
+  for(unsigned x = 0; x < 256; x++) {
+    const pixel_t &p = pixel_cache[x];
+    uint16 src_main = !swap ? p.src_main : p.src_sub;
+    uint16 src_sub  = !swap ? p.src_sub  : p.src_main;
+    uint8  bg_main  = !swap ? p.bg_main  : p.bg_sub;
+    uint8  bg_sub   = !swap ? p.bg_sub   : p.bg_main;
+    uint8  ce_main  = !swap ? p.ce_main  : p.ce_sub;
+    if(!addsub_mode) bg_sub = BACK, src_sub = regs.color_rgb;
+
+    //outside the main color window, the main source is black; outside both, math has nothing left to do
+    bool math  = !ce_main && regs.color_enabled[bg_main] && wsub[x];
+    bool halve = math && color_halve && wmain[x] && !(addsub_mode && bg_sub == BACK);
+    compose.main[x]  = wmain[x] ? src_main : 0x0000;
+    compose.sub[x]   = src_sub;
+    compose.math[x]  = -(uint16)math;
+    compose.halve[x] = -(uint16)halve;
   }
-
-  if(!p.ce_main && regs.color_enabled[p.bg_main] && window[COL].sub[x]) {
-    bool halve = false;
-    if(regs.color_halve && window[COL].main[x]) {
-      if(regs.addsub_mode && bg_sub == BACK);
-      else {
-        halve = true;
-      }
-    }
-    return addsub(src_main, src_sub, halve);
-  }
-
-  return src_main;
 }
 
-inline uint16 PPU::get_pixel_swap(uint32 x) {
-  pixel_t &p = pixel_cache[x];
-  uint16 src_main, src_sub;
-  uint8  bg_sub;
-  src_main = p.src_sub;
-
-  if(!regs.addsub_mode) {
-    bg_sub  = BACK;
-    src_sub = regs.color_rgb;
-  } else {
-    bg_sub  = p.bg_main;
-    src_sub = p.src_main;
-  }
-
-  if(!window[COL].main[x]) {
-    if(!window[COL].sub[x]) {
-      return 0x0000;
+//output[x] = math[x] ? addsub(main[x], sub[x], halve[x]) : main[x]
+inline void PPU::compose_math(uint16 *output) {
+  #if defined(__SSE2__)
+  //addsub() on eight pixels per step; every intermediate fits in 16 bits for bgr555 inputs
+  const __m128i mask0421 = _mm_set1_epi16(0x0421);
+  const __m128i mask8420 = _mm_set1_epi16((int16)0x8420);
+  const __m128i mask7bde = _mm_set1_epi16(0x7bde);
+
+  for(unsigned x = 0; x < 256; x += 8) {
+    __m128i a = _mm_loadu_si128((const __m128i*)(compose.main + x));
+    __m128i b = _mm_loadu_si128((const __m128i*)(compose.sub + x));
+    __m128i math  = _mm_loadu_si128((const __m128i*)(compose.math + x));
+    __m128i halve = _mm_loadu_si128((const __m128i*)(compose.halve + x));
+    __m128i full, half;
+
+    if(!regs.color_mode) {
+      __m128i sum = _mm_add_epi16(a, b);
+      __m128i low = _mm_sub_epi16(sum, _mm_and_si128(_mm_xor_si128(a, b), mask0421));
+      __m128i carry = _mm_and_si128(low, mask8420);
+      full = _mm_or_si128(_mm_sub_epi16(sum, carry), _mm_sub_epi16(carry, _mm_srli_epi16(carry, 5)));
+      half = _mm_srli_epi16(low, 1);
+    } else {
+      __m128i diff = _mm_add_epi16(_mm_sub_epi16(a, b), mask8420);
+      __m128i borrow = _mm_and_si128(_mm_sub_epi16(diff, _mm_and_si128(_mm_xor_si128(a, b), mask8420)), mask8420);
+      full = _mm_and_si128(_mm_sub_epi16(diff, borrow), _mm_sub_epi16(borrow, _mm_srli_epi16(borrow, 5)));
+      half = _mm_srli_epi16(_mm_and_si128(full, mask7bde), 1);
     }
-    src_main = 0x0000;
-  }
 
-  if(!p.ce_sub && regs.color_enabled[p.bg_sub] && window[COL].sub[x]) {
-    bool halve = false;
-    if(regs.color_halve && window[COL].main[x]) {
-      if(regs.addsub_mode && bg_sub == BACK);
-      else {
-        halve = true;
-      }
-    }
-    return addsub(src_main, src_sub, halve);
+    __m128i result = _mm_or_si128(_mm_and_si128(halve, half), _mm_andnot_si128(halve, full));
+    result = _mm_or_si128(_mm_and_si128(math, result), _mm_andnot_si128(math, a));
+    _mm_storeu_si128((__m128i*)(output + x), result);
   }
-
-  return src_main;
+  #else
+  for(unsigned x = 0; x < 256; x++) {
+    output[x] = compose.math[x] ? addsub(compose.main[x], compose.sub[x], compose.halve[x]) : compose.main[x];
+  }
+  #endif
 }
 
 inline void PPU::render_line_output() {
   uint16 *ptr = (uint16*)output + (line * 1024) + ((interlace() && field()) ? 512 : 0);
   uint16 *luma = light_table[regs.display_brightness];
+  uint16 normal[256], swap[256];
+
+  compose_operands(false);
+  compose_math(normal);
 
   if(!regs.pseudo_hires && regs.bg_mode != 5 && regs.bg_mode != 6) {
     for(unsigned x = 0; x < 256; x++) {
-      *ptr++ = luma[get_pixel_normal(x)];
+      *ptr++ = luma[normal[x]];
     }
   } else {
-    for(unsigned x = 0, prev = 0; x < 256; x++) {
-      *ptr++ = luma[get_pixel_swap(x)];
-      *ptr++ = luma[get_pixel_normal(x)];
+    compose_operands(true);
+    compose_math(swap);
+    for(unsigned x = 0; x < 256; x++) {
+      *ptr++ = luma[swap[x]];
+      *ptr++ = luma[normal[x]];
     }
   }
 }
@@ -0,0 +1,123 @@
+#ifdef PPU_CPP
+
+//captures everything, other than VRAM, OAM and CGRAM contents, that render_line() reads.
+//CPU-side latches and counters are cleared so that they do not defeat the comparison.
+void PPU::line_cache_capture() {
+  memcpy(&line_state.registers, &regs, sizeof regs);
+  memcpy(&line_state.cached, &cache, sizeof cache);
+  memcpy(&line_state.layer_enabled, &layer_enabled, sizeof layer_enabled);
+  line_state.interlace = display.interlace;
+  line_state.field = field();
+
+  auto &r = line_state.registers;
+  r.ppu1_mdr = r.ppu2_mdr = 0;
+  r.ioamaddr = r.icgramaddr = 0;
+  r.oam_baseaddr = r.oam_addr = 0;
+  r.oam_latchdata = 0;
+  r.mosaic_countdown = 0;
+  r.bg_ppu1ofslatch = r.bg_ppu2ofslatch = 0;
+  r.vram_incmode = 0;
+  r.vram_mapping = r.vram_incsize = 0;
+  r.vram_addr = 0;
+  r.m7_latch = 0;
+  r.cgram_addr = 0;
+  r.cgram_latchdata = 0;
+  r.hcounter = r.vcounter = 0;
+  r.latch_hcounter = r.latch_vcounter = r.counters_latched = 0;
+  r.vram_readbuffer = 0;
+}
+
+//returns the set of 1KB VRAM blocks the current line can read from
+uint64 PPU::line_cache_vram_mask() const {
+  auto range = [](uint16 addr, unsigned length) -> uint64 {
+    if(length >= 0x10000) return ~0ull;
+    uint64 mask = 0;
+    for(unsigned block = addr >> 10; block <= (addr + length - 1) >> 10; block++) mask |= 1ull << (block & 63);
+    return mask;
+  };
+
+  //bits per pixel of BG1-4 for each mode, as a color depth (-1 = unused)
+  static const int8 depth[8][4] = {
+    { 0,  0,  0,  0 }, { 1,  1,  0, -1 }, { 1,  1, -1, -1 }, { 2,  1, -1, -1 },
+    { 2,  0, -1, -1 }, { 1,  0, -1, -1 }, { 1, -1, -1, -1 }, {-1, -1, -1, -1 },
+  };
+  static const unsigned screen_size[4] = { 0x0800, 0x1000, 0x1000, 0x2000 };
+
+  uint64 mask = 0;
+  if(regs.bg_mode == 7) mask |= range(0x0000, 0x8000);
+
+  for(unsigned bg = 0; bg < 4; bg++) {
+    if(depth[regs.bg_mode][bg] < 0) continue;
+    if(regs.bg_enabled[bg] == false && regs.bgsub_enabled[bg] == false) continue;
+    mask |= range(regs.bg_scaddr[bg], screen_size[regs.bg_scsize[bg]]);
+    mask |= range(regs.bg_tdaddr[bg], 0x4000 << depth[regs.bg_mode][bg]);
+  }
+
+  //offset-per-tile modes read BG3's tilemap whether or not BG3 is displayed
+  if(regs.bg_mode == 2 || regs.bg_mode == 4 || regs.bg_mode == 6) {
+    mask |= range(regs.bg_scaddr[BG3], screen_size[regs.bg_scsize[BG3]]);
+  }
+
+  if(regs.bg_enabled[OAM] || regs.bgsub_enabled[OAM]) {
+    mask |= range(cache.oam_tdaddr, 0x2000);
+    mask |= range(cache.oam_tdaddr + 0x2000 + (cache.oam_nameselect << 13), 0x2000);
+  }
+
+  return mask;
+}
+
+//copies last frame's output for this line when none of its inputs have changed since it was rendered
+bool PPU::line_cache_load() {
+  line_cache_capture();
+  line_cache_t &entry = line_cache[interlace() && field()][line];
+
+  #if defined(DEBUGGER)
+  //debugger tools may edit VRAM, OAM and CGRAM directly, bypassing the change tracking below
+  if(debugger.attached) entry.valid = false;
+  #endif
+
+  if(entry.valid == false) return false;
+  if(memcmp(&entry.state, &line_state, sizeof line_state)) return false;
+  if(cgram_serial > entry.serial) return false;
+  if((regs.bg_enabled[OAM] || regs.bgsub_enabled[OAM]) && oam_serial > entry.serial) return false;
+
+  uint64 mask = line_cache_vram_mask();
+  for(unsigned block = 0; block < 64; block++) {
+    if((mask >> block) & 1) {
+      if(vram_serial[block] > entry.serial) return false;
+    }
+  }
+
+  uint16 *ptr = (uint16*)output + (line * 1024) + ((interlace() && field()) ? 512 : 0);
+  memcpy(ptr, entry.data, entry.width * sizeof(uint16));
+  return true;
+}
+
+void PPU::line_cache_store() {
+  line_cache_t &entry = line_cache[interlace() && field()][line];
+  uint16 *ptr = (uint16*)output + (line * 1024) + ((interlace() && field()) ? 512 : 0);
+  entry.valid = true;
+  entry.serial = render_serial;
+  memcpy(&entry.state, &line_state, sizeof line_state);
+  entry.width = hires() ? 512 : 256;
+  memcpy(entry.data, ptr, entry.width * sizeof(uint16));
+}
+
+void PPU::line_cache_flush() {
+  for(unsigned field = 0; field < 2; field++) {
+    for(unsigned line = 0; line < 240; line++) line_cache[field][line].valid = false;
+  }
+}
+
+void PPU::line_cache_init() {
+  memset(&line_state, 0, sizeof line_state);
+  for(unsigned field = 0; field < 2; field++) {
+    for(unsigned line = 0; line < 240; line++) memset(&line_cache[field][line].state, 0, sizeof line_state);
+  }
+  render_serial = 1;
+  for(unsigned block = 0; block < 64; block++) vram_serial[block] = 0;
+  oam_serial = cgram_serial = 0;
+  line_cache_flush();
+}
+
+#endif
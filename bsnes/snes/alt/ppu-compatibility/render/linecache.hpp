@@ -0,0 +1,29 @@
+//per-line output cache: render_line() reuses the previous frame's line when its inputs are unchanged
+struct line_state_t {
+  decltype(regs) registers;
+  decltype(cache) cached;
+  bool layer_enabled[5][4];
+  bool interlace;
+  bool field;
+} line_state;
+
+struct line_cache_t {
+  bool valid;
+  uint64 serial;  //render_serial when the line was rendered
+  line_state_t state;
+  unsigned width;
+  uint16 data[512];
+} line_cache[2][240];  //[field][line]
+
+//render_serial advances once per rendered line; memory writes that change a value are stamped with it
+uint64 render_serial;
+uint64 vram_serial[64];  //per 1KB block
+uint64 oam_serial;
+uint64 cgram_serial;
+
+void line_cache_capture();
+uint64 line_cache_vram_mask() const;
+bool line_cache_load();
+void line_cache_store();
+void line_cache_flush();
+void line_cache_init();
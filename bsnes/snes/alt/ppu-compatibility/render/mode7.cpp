@@ -56,6 +56,13 @@ void PPU::render_line_mode7(uint8 pri0_pos, uint8 pri1_pos) {
 
   int32 psx = ((a * CLIP(hofs - cx)) & ~63) + ((b * CLIP(vofs - cy)) & ~63) + ((b * mtable_y[y]) & ~63) + (cx << 8);
   int32 psy = ((c * CLIP(hofs - cx)) & ~63) + ((d * CLIP(vofs - cy)) & ~63) + ((d * mtable_y[y]) & ~63) + (cy << 8);
+
+  //without mosaic or EXTBG, coordinates step linearly across the line
+  if(bg == BG1 && regs.mode7_extbg == false && regs.mosaic_enabled[BG1] == false) {
+    render_line_mode7_span(psx, psy, a, c, pri0_pos);
+    return;
+  }
+
   for(int32 x = 0; x < 256; x++) {
     px = psx + (a * mtable_x[x]);
     py = psy + (c * mtable_x[x]);
@@ -138,6 +145,89 @@ void PPU::render_line_mode7(uint8 pri0_pos, uint8 pri1_pos) {
   }
 }
 
+//mode7 fast path: screen coordinates are stepped incrementally, and the tilemap / pixel addresses
+//for the whole line are computed before any VRAM is read; fetches and pixel writes follow in a second pass
+void PPU::render_line_mode7_span(int32 psx, int32 psy, int32 a, int32 c, uint8 pri) {
+  uint16 coarse[256];  //tilemap address
+  uint8  fine[256];    //offset within the tile; 0x40 = outside of screen area, when not repeating
+  const bool repeat = regs.mode7_repeat < 2;
+
+  #if defined(__SSE2__)
+  __m128i px0 = _mm_set_epi32(psx + a * 3, psx + a * 2, psx + a, psx);
+  __m128i py0 = _mm_set_epi32(psy + c * 3, psy + c * 2, psy + c, psy);
+  __m128i px1 = _mm_add_epi32(px0, _mm_set1_epi32(a * 4));
+  __m128i py1 = _mm_add_epi32(py0, _mm_set1_epi32(c * 4));
+  const __m128i stepx = _mm_set1_epi32(a * 8);
+  const __m128i stepy = _mm_set1_epi32(c * 8);
+  const __m128i mask7   = _mm_set1_epi32(7);
+  const __m128i mask3f8 = _mm_set1_epi32(0x3f8);
+  const __m128i outside = _mm_set1_epi32(repeat ? 0 : 0x40);
+  const __m128i screen  = _mm_set1_epi32(~1023);
+  const __m128i zero    = _mm_setzero_si128();
+
+  auto address = [&](__m128i px, __m128i py, __m128i &tile, __m128i &pixel) {
+    px = _mm_srai_epi32(px, 8);
+    py = _mm_srai_epi32(py, 8);
+    tile = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(py, mask3f8), 5), _mm_srli_epi32(_mm_and_si128(px, mask3f8), 2));
+    pixel = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(py, mask7), 3), _mm_and_si128(px, mask7));
+    __m128i inside = _mm_cmpeq_epi32(_mm_and_si128(_mm_or_si128(px, py), screen), zero);
+    pixel = _mm_or_si128(pixel, _mm_andnot_si128(inside, outside));
+  };
+
+  for(unsigned x = 0; x < 256; x += 8) {
+    __m128i tile0, tile1, pixel0, pixel1;
+    address(px0, py0, tile0, pixel0);
+    address(px1, py1, tile1, pixel1);
+    //all values are below 0x8000, so the saturating packs are exact
+    _mm_storeu_si128((__m128i*)(coarse + x), _mm_packs_epi32(tile0, tile1));
+    __m128i pixel = _mm_packs_epi32(pixel0, pixel1);
+    _mm_storel_epi64((__m128i*)(fine + x), _mm_packus_epi16(pixel, pixel));
+    px0 = _mm_add_epi32(px0, stepx), px1 = _mm_add_epi32(px1, stepx);
+    py0 = _mm_add_epi32(py0, stepy), py1 = _mm_add_epi32(py1, stepy);
+  }
+  #else
+  for(unsigned x = 0; x < 256; x++, psx += a, psy += c) {
+    int32 px = psx >> 8;
+    int32 py = psy >> 8;
+    coarse[x] = ((py & 0x3f8) << 5) | ((px & 0x3f8) >> 2);
+    fine[x] = ((py & 7) << 3) | (px & 7) | (!repeat && ((px | py) & ~1023) ? 0x40 : 0);
+  }
+  #endif
+
+  uint8 *wt_main = window[BG1].main;
+  uint8 *wt_sub  = window[BG1].sub;
+  const bool main_enabled = regs.bg_enabled[BG1];
+  const bool sub_enabled  = regs.bgsub_enabled[BG1];
+
+  for(unsigned x = 0; x < 256; x++) {
+    unsigned palette;
+    if(!(fine[x] & 0x40)) {
+      unsigned tile = memory::vram[coarse[x]];
+      palette = memory::vram[(((tile << 6) + fine[x]) << 1) + 1];
+    } else {
+      //character 0 repetition, or palette color 0, outside of screen area
+      palette = regs.mode7_repeat == 3 ? memory::vram[((fine[x] & 63) << 1) + 1] : 0;
+    }
+    if(!palette) continue;
+
+    unsigned _x = (regs.mode7_hflip == false) ? (x) : (255 - x);
+    uint16 col = regs.direct_color ? get_direct_color(0, palette) : get_palette(palette);
+
+    if(main_enabled && !wt_main[_x] && pixel_cache[_x].pri_main < pri) {
+      pixel_cache[_x].pri_main = pri;
+      pixel_cache[_x].bg_main  = BG1;
+      pixel_cache[_x].src_main = col;
+      pixel_cache[_x].ce_main  = false;
+    }
+    if(sub_enabled && !wt_sub[_x] && pixel_cache[_x].pri_sub < pri) {
+      pixel_cache[_x].pri_sub = pri;
+      pixel_cache[_x].bg_sub  = BG1;
+      pixel_cache[_x].src_sub = col;
+      pixel_cache[_x].ce_sub  = false;
+    }
+  }
+}
+
 #undef CLIP
 
 #endif
@@ -7,6 +7,7 @@
 #include "mode7.cpp"
 #include "addsub.cpp"
 #include "line.cpp"
+#include "linecache.cpp"
 
 //Mode 0: ->
 //     1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12
@@ -103,11 +104,20 @@ void PPU::render_line_mode7() {
 }
 
 void PPU::render_line() {
+  //sprite evaluation updates state the game can read ($213e range/time over, the internal OAM address),
+  //so it runs for every line, ahead of the line cache; its results are part of the cached line's state
+  render_line_oam_rto();
+
   if(regs.display_disabled == true) {
     render_line_clear();
     return;
   }
 
+  if(line_cache_load()) {
+    render_serial++;
+    return;
+  }
+
   flush_pixel_cache();
   build_window_tables(COL);
   update_bg_info();
@@ -124,6 +134,8 @@ void PPU::render_line() {
   }
 
   render_line_output();
+  line_cache_store();
+  render_serial++;
 }
 
 #endif
@@ -86,6 +86,7 @@ void render_line_oam(uint8 pri0_pos, uint8 pri1_pos, uint8 pri2_pos, uint8 pri3_
 
 //mode7.cpp
 template<unsigned bg> void render_line_mode7(uint8 pri0_pos, uint8 pri1_pos);
+void render_line_mode7_span(int32 psx, int32 psy, int32 a, int32 c, uint8 pri);
 
 //addsub.cpp
 inline uint16 addsub(uint32 x, uint32 y, bool halve);
@@ -93,7 +94,11 @@ inline uint16 addsub(uint32 x, uint32 y, bool halve);
 //line.cpp
 inline uint16 get_palette(uint8 index);
 inline uint16 get_direct_color(uint8 p, uint8 t);
-inline uint16 get_pixel_normal(uint32 x);
-inline uint16 get_pixel_swap(uint32 x);
+struct {
+  uint16 main[256], sub[256];    //color math operands
+  uint16 math[256], halve[256];  //0xffff where enabled
+} compose;
+inline void compose_operands(bool swap);
+inline void compose_math(uint16 *output);
 void   render_line_output();
 void   render_line_clear();
@@ -33,32 +33,41 @@ void PPU::build_window_table(uint8 bg, bool screen) {
     return;
   }
 
+  //the table is filled one span at a time: each window contributes at most two edges,
+  //and the mask is constant between consecutive edges
   if(regs.window1_enabled[bg] == true && regs.window2_enabled[bg] == false) {
     if(regs.window1_invert[bg] == true) std::swap(set, clr);
-    for(unsigned x = 0; x < 256; x++) {
-      table[x] = (x >= window1_left && x <= window1_right) ? set : clr;
-    }
+    memset(table, clr, 256);
+    if(window1_left <= window1_right) memset(table + window1_left, set, window1_right - window1_left + 1);
     return;
   }
 
   if(regs.window1_enabled[bg] == false && regs.window2_enabled[bg] == true) {
     if(regs.window2_invert[bg] == true) std::swap(set, clr);
-    for(unsigned x = 0; x < 256; x++) {
-      table[x] = (x >= window2_left && x <= window2_right) ? set : clr;
-    }
+    memset(table, clr, 256);
+    if(window2_left <= window2_right) memset(table + window2_left, set, window2_right - window2_left + 1);
     return;
   }
 
-  for(unsigned x = 0; x < 256; x++) {
+  unsigned edge[6] = { 0, window1_left, window1_right + 1u, window2_left, window2_right + 1u, 256 };
+  for(unsigned i = 1; i < 6; i++) {
+    for(unsigned n = i; n > 0 && edge[n - 1] > edge[n]; n--) std::swap(edge[n - 1], edge[n]);
+  }
+
+  for(unsigned i = 0; i < 5; i++) {
+    unsigned x = edge[i];
+    if(x == edge[i + 1]) continue;
     bool w1_mask = (x >= window1_left && x <= window1_right) ^ regs.window1_invert[bg];
     bool w2_mask = (x >= window2_left && x <= window2_right) ^ regs.window2_invert[bg];
 
+    bool mask;
     switch(regs.window_mask[bg]) {
-      case 0: table[x] = (w1_mask | w2_mask) == 1 ? set : clr; break;  //or
-      case 1: table[x] = (w1_mask & w2_mask) == 1 ? set : clr; break;  //and
-      case 2: table[x] = (w1_mask ^ w2_mask) == 1 ? set : clr; break;  //xor
-      case 3: table[x] = (w1_mask ^ w2_mask) == 0 ? set : clr; break;  //xnor
+      case 0: mask = (w1_mask | w2_mask) == 1; break;  //or
+      case 1: mask = (w1_mask & w2_mask) == 1; break;  //and
+      case 2: mask = (w1_mask ^ w2_mask) == 1; break;  //xor
+      case 3: mask = (w1_mask ^ w2_mask) == 0; break;  //xnor
     }
+    memset(table + x, mask ? set : clr, edge[i + 1] - x);
   }
 }
 
@@ -145,6 +145,7 @@ void PPU::serialize(serializer &s) {
 
   //better to just take a small speed hit than store all of bg_tiledata[3][] ...
   flush_tiledata_cache();
+  if(s.mode() == serializer::Load) line_cache_flush();
 
   for(unsigned n = 0; n < 6; n++) {
     s.array(window[n].main, 256);
@@ -31,27 +31,39 @@ void Audio::sample(int16 left, int16 right) {
 }
 
 void Audio::coprocessor_sample(int16 left, int16 right) {
-  if(r_frac >= 1.0) {
-    r_frac -= 1.0;
-    r_sum_l += left;
-    r_sum_r += right;
-    return;
-  }
-
-  r_sum_l += left  * r_frac;
-  r_sum_r += right * r_frac;
-
-  uint16 output_left  = sclamp<16>(int(r_sum_l / r_step));
-  uint16 output_right = sclamp<16>(int(r_sum_r / r_step));
-
-  double first = 1.0 - r_frac;
-  r_sum_l = left  * first;
-  r_sum_r = right * first;
-  r_frac = r_step - first;
+  uint32 sample = ((uint16)left << 0) + ((uint16)right << 16);
+  coprocessor_samples(&sample, 1);
+}
 
-  cop_buffer[cop_wroffset] = (output_left << 0) + (output_right << 16);
-  cop_wroffset = (cop_wroffset + 1) & 32767;
-  cop_length = (cop_length + 1) & 32767;
+//resamples a block of coprocessor samples, each packed as (left << 0) + (right << 16);
+//mixing with the S-DSP stream happens once for the whole block
+void Audio::coprocessor_samples(const uint32 *samples, unsigned count) {
+  for(unsigned i = 0; i < count; i++) {
+    int16 left  = samples[i] >>  0;
+    int16 right = samples[i] >> 16;
+
+    if(r_frac >= 1.0) {
+      r_frac -= 1.0;
+      r_sum_l += left;
+      r_sum_r += right;
+      continue;
+    }
+
+    r_sum_l += left  * r_frac;
+    r_sum_r += right * r_frac;
+
+    uint16 output_left  = sclamp<16>(int(r_sum_l / r_step));
+    uint16 output_right = sclamp<16>(int(r_sum_r / r_step));
+
+    double first = 1.0 - r_frac;
+    r_sum_l = left  * first;
+    r_sum_r = right * first;
+    r_frac = r_step - first;
+
+    cop_buffer[cop_wroffset] = (output_left << 0) + (output_right << 16);
+    cop_wroffset = (cop_wroffset + 1) & 32767;
+    cop_length = (cop_length + 1) & 32767;
+  }
   flush();
 }
 
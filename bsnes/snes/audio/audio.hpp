@@ -4,6 +4,7 @@ public:
   void coprocessor_frequency(double frequency);
   void sample(int16 left, int16 right);
   void coprocessor_sample(int16 left, int16 right);
+  void coprocessor_samples(const uint32 *samples, unsigned count);
   void init();
 
 private:
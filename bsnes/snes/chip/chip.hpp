@@ -1,5 +1,8 @@
+//coprocessor clocks are absolute timestamps on the S-CPU's coprocessor timeline (CPU::coprocessor_time),
+//in units of 1 / (cpu.frequency * frequency) seconds
 struct Coprocessor : Processor {
   alwaysinline void step(unsigned clocks);
+  alwaysinline int64 lag() const;
   alwaysinline void synchronize_cpu();
 };
 
@@ -21,6 +24,11 @@ void Coprocessor::step(unsigned clocks) {
   clock += clocks * (uint64)cpu.frequency;
 }
 
+//how far this chip trails the S-CPU, in clock units; positive when behind
+int64 Coprocessor::lag() const {
+  return cpu.coprocessor_time * frequency - clock;
+}
+
 void Coprocessor::synchronize_cpu() {
-  if(clock >= 0 && scheduler.sync != Scheduler::SynchronizeMode::All) co_switch(cpu.thread);
+  if(lag() <= 0 && scheduler.sync != Scheduler::SynchronizeMode::All) co_switch(cpu.thread);
 }
@@ -23,11 +23,7 @@ void Cx4::enter() {
     bool wasBusy = busy();
 
     if (mmio.dma) {
-      for (unsigned n = 0; n < mmio.dmaLength; n++) {
-        uint8 data = cx4bus.read(mmio.dmaSource + n);
-        add_clocks(2 + speed(mmio.dmaSource + n) + speed(mmio.dmaTarget + n));
-        cx4bus.write(mmio.dmaTarget + n, data);
-      }
+      dma_transfer();
       mmio.dma = false;
     }
 
@@ -108,17 +104,78 @@ void Cx4::change_page() {
   }
 }
 
+uint8* Cx4::bus_page(unsigned addr, bool write) {
+  Bus::Page &p = cx4bus.page[addr >> 8];
+  uint8 *data = 0;
+
+  if (p.access == &memory::cx4rom) {
+    if (write || cheat.active()) return 0;
+    data = memory::cartrom.data();
+  } else if (p.access == &memory::cx4ram) {
+    if (!write && cheat.active()) return 0;
+    data = memory::cartram.data();
+  } else if (p.access == this && (addr & 0x0c00) < 0x0c00) {
+    return dataRAM + (addr & 0x0f00);
+  }
+
+  return data ? data + p.offset + (addr & 0xffff00) : 0;
+}
+
+void Cx4::dma_transfer() {
+  unsigned n = 0;
+
+  while (n < mmio.dmaLength) {
+    unsigned source = (mmio.dmaSource + n) & 0xffffff;
+    unsigned target = (mmio.dmaTarget + n) & 0xffffff;
+    // transfer up to the next page boundary of either address
+    unsigned length = min(mmio.dmaLength - n, min(256 - (source & 0xff), 256 - (target & 0xff)));
+    unsigned clocks = 2 + speed(source) + speed(target);
+
+    uint8 *sp = bus_page(source, false);
+    uint8 *tp = bus_page(target, true);
+    if (sp && tp) {
+      // copy forward byte by byte, same as the bus path when the ranges overlap
+      for (unsigned i = 0; i < length; i++) tp[(target & 0xff) + i] = sp[(source & 0xff) + i];
+      add_clocks(clocks * length);
+    } else {
+      for (unsigned i = 0; i < length; i++) {
+        uint8 data = cx4bus.read(source + i);
+        add_clocks(clocks);
+        cx4bus.write(target + i, data);
+      }
+    }
+
+    n += length;
+  }
+}
+
 void Cx4::load_page(uint8 cachePage, uint16 programPage) {
   uint24 addr = mmio.programOffset + (programPage << 9);
   
   // used for busy flag
   mmio.cacheLoading = true;
   
-  for (unsigned i = 0; i < 256; i++) {
-    cache[cachePage].data[i] = cx4bus.read(addr); // | (cx4bus.read(addr++) << 8);
-    add_clocks(1 + speed(addr++));
-    cache[cachePage].data[i] |= (cx4bus.read(addr) << 8);
-    add_clocks(1 + speed(addr++));
+  unsigned i = 0;
+  while (i < 256) {
+    // load whole words up to the next bus page boundary
+    unsigned length = min(256 - i, (256 - (addr & 0xff)) >> 1);
+    uint8 *sp = length ? bus_page(addr, false) : 0;
+
+    if (sp) {
+      for (unsigned n = 0; n < length; n++) {
+        unsigned offset = (addr & 0xff) + (n << 1);
+        cache[cachePage].data[i + n] = sp[offset] | (sp[offset + 1] << 8);
+      }
+      add_clocks((1 + speed(addr)) * (length << 1));
+      addr += length << 1;
+      i += length;
+    } else {
+      cache[cachePage].data[i] = cx4bus.read(addr); // | (cx4bus.read(addr++) << 8);
+      add_clocks(1 + speed(addr++));
+      cache[cachePage].data[i] |= (cx4bus.read(addr) << 8);
+      add_clocks(1 + speed(addr++));
+      i++;
+    }
   }
   
   cache[cachePage].pageNumber = programPage;
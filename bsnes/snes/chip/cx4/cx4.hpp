@@ -42,6 +42,9 @@ protected:
   void nextpc();
   void change_page();
   void load_page(uint8 cachePage, uint16 programPage);
+  void dma_transfer();
+  // returns the 256-byte page containing addr if it can be accessed directly, else null
+  uint8* bus_page(unsigned addr, bool write);
 
   //registers.cpp
   uint24 register_read(uint8 addr);
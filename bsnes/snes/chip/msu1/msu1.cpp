@@ -5,10 +5,14 @@ namespace SNES {
 
 MSU1 msu1;
 
+#include "stream.cpp"
 #include "serialization.cpp"
 
 void MSU1::Enter() { msu1.enter(); }
 
+MSU1::MSU1() : datafile(64 * 1024), audiofile(256 * 1024) {
+}
+
 void MSU1::enter() {
   while(true) {
     if(scheduler.sync == Scheduler::SynchronizeMode::All) {
@@ -17,19 +21,24 @@ void MSU1::enter() {
 
     int16 left = 0, right = 0;
 
-    if(mmio.audio_play) {
-      if(audiofile.open()) {
+    if(data_pending || audio_pending) update_status();
+
+    if(mmio.audio_play && !mmio.audio_busy) {
+      if(audiofile.opened()) {
         if(audiofile.end()) {
           if(!mmio.audio_repeat) {
             mmio.audio_play = false;
             audiofile.seek(mmio.audio_offset = 8);
           } else {
-            audiofile.seek(mmio.audio_offset = mmio.audio_loop_offset);
+            audiofile.wrap();
+            mmio.audio_offset = mmio.audio_loop_offset;
           }
         } else {
           mmio.audio_offset += 4;
-          left  = audiofile.readl(2);
-          right = audiofile.readl(2);
+          left   = audiofile.read() << 0;
+          left  |= audiofile.read() << 8;
+          right  = audiofile.read() << 0;
+          right |= audiofile.read() << 8;
         }
       } else {
         mmio.audio_play = false;
@@ -48,6 +57,32 @@ void MSU1::enter() {
   }
 }
 
+//completes data seeks and track changes once the stream worker has finished them
+void MSU1::update_status() {
+  if(data_pending && !datafile.busy()) {
+    data_pending = false;
+    mmio.data_busy = false;
+  }
+
+  if(audio_pending && !audiofile.busy()) {
+    audio_pending = false;
+    mmio.audio_busy = false;
+
+    if(audiofile.opened()) {
+      const uint8 *header = audiofile.header();
+      if(memcmp(header, "MSU1", 4)) {  //verify 'MSU1' header
+        audiofile.close();
+      } else {
+        mmio.audio_loop_offset = 8 + (header[4] | header[5] << 8 | header[6] << 16 | header[7] << 24) * 4;
+        if(mmio.audio_loop_offset > audiofile.size())
+          mmio.audio_loop_offset = 8;
+        audiofile.loop(mmio.audio_loop_offset);
+      }
+    }
+    mmio.audio_error = !audiofile.opened();
+  }
+}
+
 void MSU1::init() {
 }
 
@@ -55,13 +90,12 @@ void MSU1::enable() {
   audio.coprocessor_enable(true);
   audio.coprocessor_frequency(44100.0);
 
-  if(datafile.open()) datafile.close();
-  datafile.open(string(cartridge.basename(), ".msu"), file::mode::read);
+  datafile.open(string(cartridge.basename(), ".msu"));
 }
 
 void MSU1::unload() {
-  if(datafile.open()) datafile.close();
-  if(audiofile.open()) audiofile.close();
+  datafile.close();
+  audiofile.close();
 }
 
 void MSU1::power() {
@@ -83,10 +117,13 @@ void MSU1::reset() {
   mmio.audio_repeat = false;
   mmio.audio_play   = false;
   mmio.audio_error  = false;
+  data_pending  = false;
+  audio_pending = false;
 }
 
 uint8 MSU1::mmio_read(unsigned addr) {
   if(addr == 0x2000) {
+    if(data_pending || audio_pending) update_status();
     return (mmio.data_busy    << 7)
          | (mmio.audio_busy   << 6)
          | (mmio.audio_repeat << 5)
@@ -98,7 +135,7 @@ uint8 MSU1::mmio_read(unsigned addr) {
   if(addr == 0x2001) {
     if(Memory::debugger_access() || mmio.data_busy) return 0x00;
     mmio.data_offset++;
-    if(datafile.open()) return datafile.read();
+    if(datafile.opened()) return datafile.read();
     return 0x00;
   }
 
@@ -128,8 +165,9 @@ void MSU1::mmio_write(unsigned addr, uint8 data) {
   if(addr == 0x2003) {
     mmio.data_seek_offset = (mmio.data_seek_offset & 0x00ffffff) | (data << 24);
     mmio.data_offset = mmio.data_seek_offset;
-    if(datafile.open()) datafile.seek(mmio.data_offset);
-    mmio.data_busy = false;
+    datafile.seek(mmio.data_offset);
+    mmio.data_busy = true;
+    data_pending = true;
   }
 
   if(addr == 0x2004) {
@@ -146,23 +184,12 @@ void MSU1::mmio_write(unsigned addr, uint8 data) {
       mmio.audio_resume_offset = 0;
     }
     
-    if(audiofile.open()) audiofile.close();
-    if(audiofile.open(string(cartridge.basename(), "-", mmio.audio_track, ".pcm"), file::mode::read)) {
-      uint32 header = audiofile.readm(4);
-      if(header != 0x4d535531) {  //verify 'MSU1' header
-        audiofile.close();
-      } else {
-        mmio.audio_loop_offset = 8 + audiofile.readl(4) * 4;
-        if(mmio.audio_loop_offset > audiofile.size())
-          mmio.audio_loop_offset = 8;
-
-        audiofile.seek(mmio.audio_offset);
-      }
-    }
-    mmio.audio_busy   = false;
+    audiofile.open(string(cartridge.basename(), "-", mmio.audio_track, ".pcm"), mmio.audio_offset);
+    mmio.audio_busy   = true;
     mmio.audio_repeat = false;
     mmio.audio_play   = false;
-    mmio.audio_error  = !audiofile.open();
+    mmio.audio_error  = false;
+    audio_pending = true;
   }
 
   if(addr == 0x2006) {
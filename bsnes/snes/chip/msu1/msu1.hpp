@@ -1,3 +1,5 @@
+#include "stream.hpp"
+
 class MSU1 : public Coprocessor, public MMIO {
 public:
   static void Enter();
@@ -12,10 +14,15 @@ public:
   void mmio_write(unsigned addr, uint8 data);
 
   void serialize(serializer&);
+  MSU1();
 
 private:
-  file datafile;
-  file audiofile;
+  MSU1Stream datafile;
+  MSU1Stream audiofile;
+  bool data_pending;   //a data seek is in progress
+  bool audio_pending;  //a track change is in progress
+
+  void update_status();
 
   enum Flag {
     DataBusy       = 0x80,
@@ -1,6 +1,11 @@
 #ifdef MSU1_CPP
 
 void MSU1::serialize(serializer &s) {
+  //complete any outstanding seek or track change so it is not lost in the saved state
+  datafile.wait();
+  audiofile.wait();
+  update_status();
+
   Processor::serialize(s);
 
   s.integer(mmio.data_offset);
@@ -19,14 +24,14 @@ void MSU1::serialize(serializer &s) {
   s.integer(mmio.audio_play);
   s.integer(mmio.audio_error);
 
-  if(datafile.open()) datafile.close();
-  if(datafile.open(string(cartridge.basename(), ".msu"), file::mode::read)) {
-    datafile.seek(mmio.data_offset);
-  }
-
-  if(audiofile.open()) audiofile.close();
-  if(audiofile.open(string(cartridge.basename(), "-", mmio.audio_track, ".pcm"), file::mode::read)) {
-    audiofile.seek(mmio.audio_offset);
+  if(s.mode() == serializer::Load) {
+    datafile.open(string(cartridge.basename(), ".msu"), mmio.data_offset);
+    audiofile.open(string(cartridge.basename(), "-", mmio.audio_track, ".pcm"), mmio.audio_offset);
+    datafile.wait();
+    audiofile.wait();
+    if(audiofile.opened()) audiofile.loop(mmio.audio_loop_offset);
+    data_pending  = false;
+    audio_pending = false;
   }
 }
 
@@ -0,0 +1,202 @@
+#ifdef MSU1_CPP
+
+bool MSU1Stream::busy() {
+  std::lock_guard<std::mutex> guard(lock);
+  return completed != request;
+}
+
+bool MSU1Stream::opened() {
+  std::lock_guard<std::mutex> guard(lock);
+  return file_opened;
+}
+
+unsigned MSU1Stream::size() {
+  std::lock_guard<std::mutex> guard(lock);
+  return file_size;
+}
+
+unsigned MSU1Stream::offset() {
+  return read_offset;
+}
+
+bool MSU1Stream::end() {
+  return read_offset >= size();
+}
+
+const uint8* MSU1Stream::header() {
+  return file_header;
+}
+
+void MSU1Stream::open(const string &filename, unsigned offset) {
+  if(!thread.joinable()) thread = std::thread(&MSU1Stream::worker, this);
+
+  std::lock_guard<std::mutex> guard(lock);
+  request++;
+  request_open = true;
+  request_name = filename;
+  request_offset = offset;
+  file_opened = false;
+  loop_offset = ~0;
+  head = count = 0;
+  chunk_offset = chunk_size = 0;
+  read_offset = offset;
+  producer.notify_one();
+}
+
+void MSU1Stream::seek(unsigned offset) {
+  std::lock_guard<std::mutex> guard(lock);
+  request++;
+  request_offset = offset;
+  head = count = 0;
+  chunk_offset = chunk_size = 0;
+  read_offset = offset;
+  producer.notify_one();
+}
+
+void MSU1Stream::loop(unsigned offset) {
+  std::lock_guard<std::mutex> guard(lock);
+  loop_offset = offset;
+  producer.notify_one();
+}
+
+//the worker buffers the loop offset directly after the end of the file, so the data
+//following the read position is already the data at the loop offset
+void MSU1Stream::wrap() {
+  std::lock_guard<std::mutex> guard(lock);
+  read_offset = loop_offset;
+}
+
+void MSU1Stream::close() {
+  if(!thread.joinable()) return;
+  open("");
+}
+
+void MSU1Stream::wait() {
+  std::unique_lock<std::mutex> guard(lock);
+  while(completed != request) consumer.wait(guard);
+}
+
+uint8 MSU1Stream::read() {
+  if(chunk_offset == chunk_size) fill();
+  if(chunk_offset == chunk_size || read_offset >= read_limit) return 0xff;  //end of file, or file not open
+  read_offset++;
+  return chunk[chunk_offset++];
+}
+
+//moves the next chunk out of the ring buffer, waiting for the worker if it has fallen behind
+void MSU1Stream::fill() {
+  std::unique_lock<std::mutex> guard(lock);
+  while(completed != request || (count == 0 && file_opened && (fetch_offset < file_size || loop_offset < file_size))) {
+    consumer.wait(guard);
+  }
+  read_limit = file_size;
+
+  chunk_offset = 0;
+  chunk_size = min(count, (unsigned)ChunkSize);
+  unsigned length = min(chunk_size, capacity - head);
+  memcpy(chunk, ring + head, length);
+  memcpy(chunk + length, ring, chunk_size - length);
+  head = (head + chunk_size) % capacity;
+  count -= chunk_size;
+  producer.notify_one();
+}
+
+void MSU1Stream::worker() {
+  file fp;
+  uint8 buffer[ChunkSize];
+  std::unique_lock<std::mutex> guard(lock);
+
+  while(!quit) {
+    if(completed != request) {
+      unsigned id = request;
+      bool reopen = request_open;
+      string name = request_name;
+      unsigned offset = request_offset;
+      request_open = false;
+      guard.unlock();
+
+      uint8 data[8];
+      if(reopen) {
+        if(fp.open()) fp.close();
+        if(name != "") fp.open(name, file::mode::read);
+        fp.read(data, 8);
+      }
+      fp.seek(offset);
+      unsigned length = fp.open() ? min((unsigned)ChunkSize, fp.size() - min(offset, (unsigned)fp.size())) : 0;
+      fp.read(buffer, length);
+
+      guard.lock();
+      if(reopen) {
+        file_opened = fp.open();
+        file_size = fp.open() ? fp.size() : 0;
+        memcpy(file_header, data, 8);
+      }
+      if(id == request) {
+        //prime the buffer so the first reads after the request completes do not stall
+        memcpy(ring, buffer, length);
+        head = 0;
+        count = length;
+        fetch_offset = offset + length;
+      }
+      completed = id;
+      consumer.notify_all();
+      continue;
+    }
+
+    //the end of the file is followed by the data at the loop offset
+    if(fetch_offset >= file_size && loop_offset < file_size) fetch_offset = loop_offset;
+
+    if(fp.open() && fetch_offset < file_size && count < capacity) {
+      unsigned id = request;
+      unsigned offset = fetch_offset;
+      unsigned tail = (head + count) % capacity;
+      unsigned length = min(min((unsigned)ChunkSize, capacity - count), file_size - fetch_offset);
+      length = min(length, capacity - tail);
+      guard.unlock();
+
+      if((unsigned)fp.offset() != offset) fp.seek(offset);
+      fp.read(buffer, length);
+
+      guard.lock();
+      if(id != request) continue;  //superseded by a seek; its handler repositions fp
+      memcpy(ring + tail, buffer, length);
+      count += length;
+      fetch_offset += length;
+      consumer.notify_all();
+      continue;
+    }
+
+    producer.wait(guard);
+  }
+}
+
+MSU1Stream::MSU1Stream(unsigned capacity) : capacity(capacity) {
+  quit = false;
+  request = completed = 0;
+  request_open = false;
+  request_offset = 0;
+  file_opened = false;
+  file_size = 0;
+  memset(file_header, 0xff, sizeof file_header);
+  ring = new uint8[capacity];
+  head = count = 0;
+  fetch_offset = 0;
+  loop_offset = ~0;
+  chunk_offset = chunk_size = 0;
+  read_offset = 0;
+  read_limit = 0;
+}
+
+MSU1Stream::~MSU1Stream() {
+  if(thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      quit = true;
+      producer.notify_one();
+    }
+    thread.join();
+  }
+  delete[] ring;
+}
+
+#endif
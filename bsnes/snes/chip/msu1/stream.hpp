@@ -0,0 +1,63 @@
+//prefetching file reader used by the MSU-1 for its data and audio files.
+//all file I/O (open, seek, read) happens on a worker thread, which keeps a ring buffer
+//filled ahead of the read position; the emulation thread only copies out of that buffer.
+//with a loop offset set, the worker continues buffering at the loop offset after the end
+//of the file, so that looping tracks wrap around without a seek.
+
+class MSU1Stream {
+public:
+  bool busy();     //an open or seek request has not completed yet
+  bool opened();   //valid once busy() returns false
+  unsigned size();
+  unsigned offset();
+  bool end();
+  const uint8* header();  //first eight bytes of the file
+
+  void open(const string &filename, unsigned offset = 0);
+  void seek(unsigned offset);
+  void loop(unsigned offset);  //sets the offset wrap() continues at, valid until the next open
+  void wrap();                 //continues reading at the loop offset, once end() is reached
+  void close();
+  void wait();
+  uint8 read();
+
+  MSU1Stream(unsigned capacity);
+  ~MSU1Stream();
+
+private:
+  enum : unsigned { ChunkSize = 4096 };
+
+  void worker();
+  void fill();
+
+  std::thread thread;
+  std::mutex lock;
+  std::condition_variable producer;
+  std::condition_variable consumer;
+
+  //shared with the worker thread, guarded by lock
+  bool quit;
+  unsigned request;        //incremented on every open/seek/close
+  unsigned completed;      //last request the worker has finished
+  bool request_open;
+  string request_name;
+  unsigned request_offset;
+
+  bool file_opened;
+  unsigned file_size;
+  uint8 file_header[8];
+
+  uint8 *ring;
+  unsigned capacity;
+  unsigned head;
+  unsigned count;
+  unsigned fetch_offset;   //file offset of the byte following the buffered data
+  unsigned loop_offset;    //~0 when not looping
+
+  //owned by the emulation thread
+  uint8 chunk[ChunkSize];
+  unsigned chunk_offset;
+  unsigned chunk_size;
+  unsigned read_offset;
+  unsigned read_limit;     //file size, as of the last fill()
+};
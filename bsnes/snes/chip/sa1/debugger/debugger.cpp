@@ -9,6 +9,8 @@ uint8 SA1Debugger::disassembler_read(uint32 addr)
 }
 
 void SA1Debugger::op_step() {
+  if(!debugger.attached) return;
+
   bool break_event = false;
 
   usage[regs.pc] &= ~(UsageFlagM | UsageFlagX);
@@ -55,6 +57,8 @@ void SA1Debugger::op_step() {
 }
 
 alwaysinline uint8_t SA1Debugger::op_readpc() {
+  if(!debugger.attached) return SA1::op_read((regs.pc.b << 16) + regs.pc.w++);
+
   usage[regs.pc] |= UsageExec;
   
   int offset = cartridge.rom_offset(regs.pc);
@@ -66,6 +70,8 @@ alwaysinline uint8_t SA1Debugger::op_readpc() {
 
 uint8 SA1Debugger::op_read(uint32 addr) {
   uint8 data = SA1::op_read(addr);
+  if(!debugger.attached) return data;
+
   // ignore dummy reads that can be caused by interrupts
   if (!interrupt_pending()) {
     usage[addr] |= UsageRead;
@@ -81,6 +87,8 @@ uint8 SA1Debugger::op_read(uint32 addr) {
 // TODO: SA-1 DMA/HDMA
 
 void SA1Debugger::op_write(uint32 addr, uint8 data) {
+  if(!debugger.attached) return SA1::op_write(addr, data);
+
   debugger.breakpoint_test(Debugger::Breakpoint::Source::SA1Bus, Debugger::Breakpoint::Mode::Write, addr, data);
   SA1::op_write(addr, data);
   usage[addr] |= UsageWrite;
@@ -89,16 +97,11 @@ void SA1Debugger::op_write(uint32 addr, uint8 data) {
 
 // TODO: SA-1 MMIO, bitmap RAM access and stuff
 
-SA1Debugger::SA1Debugger() {
-  usage = new uint8[1 << 24]();
+SA1Debugger::SA1Debugger() : usage(1 << 24) {
   cart_usage = &SNES::cpu.cart_usage;
   opcode_pc = 0x8000;
 }
 
-SA1Debugger::~SA1Debugger() {
-  delete[] usage;
-}
-
 bool SA1Debugger::property(unsigned id, string &name, string &value) {
   unsigned n = 0;
 
@@ -39,8 +39,8 @@ public:
     UsageFlagM  = 0x02,
     UsageFlagX  = 0x01,
   };
-  uint8 *usage;
-  uint8 **cart_usage;
+  UsageMap usage;
+  UsageMap *cart_usage;
 
   uint24 opcode_pc;  //points to the current opcode, used to backtrace on read/write breakpoints
 
@@ -52,5 +52,4 @@ public:
   uint8 disassembler_read(uint32 addr);
   
   SA1Debugger();
-  ~SA1Debugger();
 };
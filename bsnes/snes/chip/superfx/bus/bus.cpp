@@ -73,7 +73,7 @@ unsigned SuperFXCPUROM::size() const {
 }
 
 uint8 SuperFXCPUROM::read(unsigned addr) {
-  if(superfx.regs.sfr.g && superfx.regs.scmr.ron) {
+  if(superfx.worker.active || (superfx.regs.sfr.g && superfx.regs.scmr.ron)) {
     static const uint8_t data[16] = {
       0x00, 0x01, 0x00, 0x01, 0x04, 0x01, 0x00, 0x01,
       0x00, 0x01, 0x08, 0x01, 0x00, 0x01, 0x0c, 0x01,
@@ -92,11 +92,12 @@ unsigned SuperFXCPURAM::size() const {
 }
 
 uint8 SuperFXCPURAM::read(unsigned addr) {
-  if(superfx.regs.sfr.g && superfx.regs.scmr.ran && !debugger_access()) return cpu.regs.mdr;
+  if((superfx.worker.active || (superfx.regs.sfr.g && superfx.regs.scmr.ran)) && !debugger_access()) return cpu.regs.mdr;
   return memory::cartram.read(addr);
 }
 
 void SuperFXCPURAM::write(unsigned addr, uint8 data) {
+  if(superfx.worker.active) return;  //the GSU owns RAM, and is writing it from the worker thread
   memory::cartram.write(addr, data);
 }
 
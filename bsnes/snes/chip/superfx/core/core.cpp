@@ -47,10 +47,17 @@ void SuperFX::plot(uint8 x, uint8 y) {
   }
 }
 
-uint8 SuperFX::rpix(uint8 x, uint8 y) {
-  pixelcache_flush(pixelcache[1]);
-  pixelcache_flush(pixelcache[0]);
+//returns a pointer to the start of the 256-byte game pak RAM page containing addr,
+//or null if the access must go through superfxbus (unmapped, or cheat codes are active)
+uint8* SuperFX::plot_page(unsigned addr) {
+  if(cheat.active()) return 0;
+  Bus::Page &p = superfxbus.page[addr >> 8];
+  if(p.access != &memory::gsuram) return 0;
+  return memory::cartram.data() + p.offset + (addr & 0xffff00);
+}
 
+//computes the address of the first bitplane byte of the character row containing (x, y)
+unsigned SuperFX::plot_addr(uint8 x, uint8 y) {
   unsigned cn;  //character number
   switch(regs.por.obj ? 3 : regs.scmr.ht) {
     case 0: cn = ((x & 0xf8) << 1) + ((y & 0xf8) >> 3); break;
@@ -59,14 +66,25 @@ uint8 SuperFX::rpix(uint8 x, uint8 y) {
     case 3: cn = ((y & 0x80) << 2) + ((x & 0x80) << 1) + ((y & 0x78) << 1) + ((x & 0x78) >> 3); break;
   }
   unsigned bpp = 2 << (regs.scmr.md - (regs.scmr.md >> 1));  // = [regs.scmr.md]{ 2, 4, 4, 8 };
-  unsigned addr = 0x700000 + (cn * (bpp << 3)) + (regs.scbr << 10) + ((y & 0x07) * 2);
+  return 0x700000 + (cn * (bpp << 3)) + (regs.scbr << 10) + ((y & 0x07) * 2);
+}
+
+uint8 SuperFX::rpix(uint8 x, uint8 y) {
+  pixelcache_flush(pixelcache[1]);
+  pixelcache_flush(pixelcache[0]);
+
+  unsigned bpp = 2 << (regs.scmr.md - (regs.scmr.md >> 1));  // = [regs.scmr.md]{ 2, 4, 4, 8 };
+  unsigned addr = plot_addr(x, y);
+  //all bitplanes of a character row lie within one 256-byte page
+  uint8 *page = plot_page(addr);
   uint8 data = 0x00;
   x = (x & 7) ^ 7;
 
   for(unsigned n = 0; n < bpp; n++) {
     unsigned byte = ((n >> 1) << 4) + (n & 1);  // = [n]{ 0, 1, 16, 17, 32, 33, 48, 49 };
     add_clocks(memory_access_speed());
-    data |= ((superfxbus.read(addr + byte) >> x) & 1) << n;
+    uint8 plane = page && regs.scmr.ran ? page[(addr + byte) & 0xff] : superfxbus.read(addr + byte);
+    data |= ((plane >> x) & 1) << n;
   }
 
   return data;
@@ -78,27 +96,26 @@ void SuperFX::pixelcache_flush(pixelcache_t &cache) {
   uint8 x = cache.offset << 3;
   uint8 y = cache.offset >> 5;
 
-  unsigned cn;  //character number
-  switch(regs.por.obj ? 3 : regs.scmr.ht) {
-    case 0: cn = ((x & 0xf8) << 1) + ((y & 0xf8) >> 3); break;
-    case 1: cn = ((x & 0xf8) << 1) + ((x & 0xf8) >> 1) + ((y & 0xf8) >> 3); break;
-    case 2: cn = ((x & 0xf8) << 1) + ((x & 0xf8) << 0) + ((y & 0xf8) >> 3); break;
-    case 3: cn = ((y & 0x80) << 2) + ((x & 0x80) << 1) + ((y & 0x78) << 1) + ((x & 0x78) >> 3); break;
-  }
   unsigned bpp = 2 << (regs.scmr.md - (regs.scmr.md >> 1));  // = [regs.scmr.md]{ 2, 4, 4, 8 };
-  unsigned addr = 0x700000 + (cn * (bpp << 3)) + (regs.scbr << 10) + ((y & 0x07) * 2);
+  unsigned addr = plot_addr(x, y);
+  uint8 *page = plot_page(addr);
+
+  //transpose the cached row: byte n of planes holds bitplane n
+  uint64 planes = 0;
+  for(unsigned x = 0; x < 8; x++) planes |= plot_planes[cache.data[x]] << x;
 
   for(unsigned n = 0; n < bpp; n++) {
     unsigned byte = ((n >> 1) << 4) + (n & 1);  // = [n]{ 0, 1, 16, 17, 32, 33, 48, 49 };
-    uint8 data = 0x00;
-    for(unsigned x = 0; x < 8; x++) data |= ((cache.data[x] >> n) & 1) << x;
+    uint8 data = planes >> (n << 3);
     if(cache.bitpend != 0xff) {
       add_clocks(memory_access_speed());
       data &= cache.bitpend;
-      data |= superfxbus.read(addr + byte) & ~cache.bitpend;
+      uint8 plane = page && regs.scmr.ran ? page[(addr + byte) & 0xff] : superfxbus.read(addr + byte);
+      data |= plane & ~cache.bitpend;
     }
     add_clocks(memory_access_speed());
-    superfxbus.write(addr + byte, data);
+    if(page && regs.scmr.ran) page[(addr + byte) & 0xff] = data;
+    else superfxbus.write(addr + byte, data);
   }
 
   cache.bitpend = 0x00;
@@ -4,6 +4,9 @@ uint8 color(uint8 source);
 void plot(uint8 x, uint8 y);
 uint8 rpix(uint8 x, uint8 y);
 void pixelcache_flush(pixelcache_t &cache);
+uint8* plot_page(unsigned addr);
+unsigned plot_addr(uint8 x, uint8 y);
+uint64 plot_planes[256];
 
 //opcode_table.cpp
 inline void op_exec(uint8 opcode);
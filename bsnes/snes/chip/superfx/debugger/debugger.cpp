@@ -8,7 +8,7 @@ void SFXDebugger::reset() {
 }
 
 void SFXDebugger::op_step() {
-  if (pc_valid) {
+  if (debugger.attached && pc_valid) {
     usage[opcode_pc] |= UsageOpcode;
 
     if(debugger.step_sfx &&
@@ -25,7 +25,11 @@ void SFXDebugger::op_step() {
   }
 }
 
+//detached: a worker window was still closing when a tool attached; the worker thread must not
+//touch the usage maps or reach scheduler.exit() through a breakpoint, so it forwards straight on
 uint8 SFXDebugger::op_read(uint16 addr) {
+  if(detached || !debugger.attached) return SuperFX::op_read(addr);
+
   pc_valid = true;
   opcode_pc = addr + (regs.pbr << 16);
   usage[opcode_pc] |= UsageExec;
@@ -37,6 +41,8 @@ uint8 SFXDebugger::op_read(uint16 addr) {
 }
 
 uint8 SFXDebugger::rombuffer_read() {
+  if(detached || !debugger.attached) return SuperFX::rombuffer_read();
+
   uint32 fulladdr = (regs.rombr << 16) + regs.r[14];
   usage[fulladdr] |= UsageRead;
   
@@ -52,6 +58,8 @@ uint8 SFXDebugger::rombuffer_read() {
 }
 
 uint8 SFXDebugger::rambuffer_read(uint16 addr) {
+  if(detached || !debugger.attached) return SuperFX::rambuffer_read(addr);
+
   uint32 fulladdr = 0x700000 + (regs.rambr << 16) + addr;
   usage[fulladdr] |= UsageRead;
   
@@ -64,6 +72,8 @@ uint8 SFXDebugger::rambuffer_read(uint16 addr) {
 }
 
 void SFXDebugger::rambuffer_write(uint16 addr, uint8 data) {
+  if(detached || !debugger.attached) return SuperFX::rambuffer_write(addr, data);
+
   uint32 fulladdr = 0x700000 + (regs.rambr << 16) + addr;
   usage[fulladdr] |= UsageWrite;
   
@@ -71,15 +81,10 @@ void SFXDebugger::rambuffer_write(uint16 addr, uint8 data) {
   SuperFX::rambuffer_write(addr, data);
 }
 
-SFXDebugger::SFXDebugger() {
-  usage = new uint8[1 << 23]();
+SFXDebugger::SFXDebugger() : usage(1 << 23) {
   cart_usage = &SNES::cpu.cart_usage;
 }
 
-SFXDebugger::~SFXDebugger() {
-  delete[] usage;
-}
-
 bool SFXDebugger::property(unsigned id, string &name, string &value) {
   unsigned n = 0;
 
@@ -35,8 +35,8 @@ public:
     UsageExec   = 0x20,
     UsageOpcode = 0x10,
   };
-  uint8 *usage;
-  uint8 **cart_usage;
+  UsageMap usage;
+  UsageMap *cart_usage;
 
   uint24 opcode_pc;  //points to the current opcode, used to backtrace on read/write breakpoints
   bool pc_valid;
@@ -55,5 +55,4 @@ public:
   void rambuffer_write(uint16 addr, uint8 data);
 
   SFXDebugger();
-  ~SFXDebugger();
 };
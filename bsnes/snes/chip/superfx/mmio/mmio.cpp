@@ -4,6 +4,15 @@ uint8 SuperFX::mmio_read(unsigned addr) {
   if(!Memory::debugger_access())
     cpu.synchronize_coprocessor();
 
+  if(worker.active) {
+    //polling SFR while the GSU is still running does not need to stop it
+    if(addr == 0x3030 && !Memory::debugger_access()) {
+      uint16 sfr = worker.sfr.load(std::memory_order_relaxed);
+      if(sfr & 0x20) return sfr;
+    }
+    worker_join();
+  }
+
   if(addr >= 0x3100 && addr <= 0x32ff) {
     return cache_mmio_read(addr - 0x3100);
   }
@@ -56,6 +65,7 @@ uint8 SuperFX::mmio_read(unsigned addr) {
 
 void SuperFX::mmio_write(unsigned addr, uint8 data) {
   cpu.synchronize_coprocessor();
+  worker_join();
 
   if(addr >= 0x3100 && addr <= 0x32ff) {
     return cache_mmio_write(addr - 0x3100, data);
@@ -1,6 +1,7 @@
 #ifdef SUPERFX_CPP
 
 void SuperFX::serialize(serializer &s) {
+  worker_join();
   Processor::serialize(s);
 
   //core/registers.hpp
@@ -10,6 +10,7 @@ namespace SNES {
 #include "mmio/mmio.cpp"
 #include "timing/timing.cpp"
 #include "disasm/disasm.cpp"
+#include "worker/worker.cpp"
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.cpp"
@@ -31,6 +32,11 @@ void SuperFX::enter() {
       continue;
     }
 
+    if(config.superfx.threaded && worker_allowed() && regs.scmr.ron && regs.scmr.ran) {
+      worker_run();
+      continue;
+    }
+
     op_step();
 
     op_exec(peekpipe());
@@ -41,6 +47,12 @@ void SuperFX::enter() {
 void SuperFX::init() {
   regs.r[14].on_modify = { &SuperFX::r14_modify, this };
   regs.r[15].on_modify = { &SuperFX::r15_modify, this };
+
+  //spreads the bits of a color value into the low bit of each byte, one byte per bitplane
+  for(unsigned color = 0; color < 256; color++) {
+    plot_planes[color] = 0;
+    for(unsigned n = 0; n < 8; n++) plot_planes[color] |= (uint64)((color >> n) & 1) << (n << 3);
+  }
 }
 
 void SuperFX::enable() {
@@ -52,6 +64,7 @@ void SuperFX::power() {
 }
 
 void SuperFX::reset() {
+  worker_join();
   create(SuperFX::Enter, system.cpu_frequency());
   superfxbus.init();
 
@@ -80,4 +93,19 @@ void SuperFX::reset() {
   timing_reset();
 }
 
+void SuperFX::unload() {
+  worker_join();
+}
+
+SuperFX::SuperFX() {
+  worker.quit = false;
+  worker.running = false;
+  worker.active = false;
+  detached = false;
+}
+
+SuperFX::~SuperFX() {
+  worker_term();
+}
+
 }
@@ -7,6 +7,7 @@ public:
   #include "mmio/mmio.hpp"
   #include "timing/timing.hpp"
   #include "disasm/disasm.hpp"
+  #include "worker/worker.hpp"
 
   static void Enter();
   void enter();
@@ -14,8 +15,12 @@ public:
   void enable();
   void power();
   debugvirtual void reset();
+  void unload();
   void serialize(serializer&);
 
+  SuperFX();
+  ~SuperFX();
+
   // used by the superfx debugger prior to executing instructions
   debugvirtual void op_step() {};
 };
@@ -25,6 +25,11 @@ void SuperFX::add_clocks(unsigned clocks) {
     }
   }
 
+  if(detached) {
+    worker.clocks += clocks;
+    return;
+  }
+
   step(clocks);
   synchronize_cpu();
 }
@@ -0,0 +1,95 @@
+#ifdef SUPERFX_CPP
+
+//the debugger hooks write the usage maps and deliver breakpoints through scheduler.exit(), which only works
+//on a cothread; so GSU code only goes to the worker while no debugging tool is attached
+bool SuperFX::worker_allowed() const {
+  #if defined(DEBUGGER)
+  return debugger.attached == false;
+  #else
+  return true;
+  #endif
+}
+
+//cothread side: hands the GSU to the worker, then advances the GSU clock in scanline steps
+//so the S-CPU keeps running, until the window ends or the S-CPU joins it
+void SuperFX::worker_run() {
+  if(!worker.thread.joinable()) worker.thread = std::thread(&SuperFX::worker_entry, this);
+
+  worker.active = true;
+  worker.clocks = 0;
+  worker.stepped = 0;
+  worker.irq = false;
+  worker.stop = false;
+  worker.sfr = regs.sfr;
+  {
+    std::lock_guard<std::mutex> guard(worker.lock);
+    worker.running = true;
+    worker.wake.notify_one();
+  }
+
+  while(worker.active) {
+    bool running;
+    {
+      std::lock_guard<std::mutex> guard(worker.lock);
+      running = worker.running;
+    }
+    if(running == false || !worker_allowed() || scheduler.sync == Scheduler::SynchronizeMode::All) return worker_join();
+
+    step(WorkerStep);
+    worker.stepped += WorkerStep;
+    synchronize_cpu();
+  }
+}
+
+//emulation thread: ends the window, and accounts for the clocks and IRQ of the work done on the worker
+void SuperFX::worker_join() {
+  if(worker.active == false) return;
+
+  worker.stop = true;
+  {
+    std::unique_lock<std::mutex> guard(worker.lock);
+    while(worker.running) worker.done.wait(guard);
+  }
+  worker.active = false;
+
+  //replace the time advanced on the worker's behalf with the time the GSU actually took;
+  //finishing early leaves the GSU behind the S-CPU, so it idles forward on its cothread as usual
+  clock += ((int64)worker.clocks - (int64)worker.stepped) * (int64)cpu.frequency;
+  cpu.coprocessor_schedule();
+  if(worker.irq) cpu.regs.irq = 1;
+}
+
+void SuperFX::worker_entry() {
+  std::unique_lock<std::mutex> guard(worker.lock);
+  while(true) {
+    while(worker.running == false && worker.quit == false) worker.wake.wait(guard);
+    if(worker.quit) return;
+    guard.unlock();
+
+    //op_step() is skipped: debugger events cannot be delivered from this thread
+    detached = true;
+    while(regs.sfr.g && worker.stop.load(std::memory_order_relaxed) == false) {
+      op_exec(peekpipe());
+      if(r15_modified == false) regs.r[15]++;
+      worker.sfr.store(regs.sfr, std::memory_order_relaxed);
+    }
+    detached = false;
+
+    guard.lock();
+    worker.running = false;
+    worker.done.notify_all();
+  }
+}
+
+void SuperFX::worker_term() {
+  worker_join();
+  if(worker.thread.joinable() == false) return;
+  {
+    std::lock_guard<std::mutex> guard(worker.lock);
+    worker.quit = true;
+    worker.wake.notify_one();
+  }
+  worker.thread.join();
+}
+
+#endif
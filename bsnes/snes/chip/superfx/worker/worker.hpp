@@ -0,0 +1,33 @@
+//optional host-thread execution of the GSU (config.superfx.threaded).
+//while the GSU owns both game pak ROM and RAM, the S-CPU can only poll SFR or wait for the IRQ,
+//so the GSU runs freely on a worker thread until STOP; the S-CPU only waits for it when it
+//touches any other GSU register, which hands the GSU back to its cothread.
+struct Worker {
+  std::thread thread;
+  std::mutex lock;
+  std::condition_variable wake;
+  std::condition_variable done;
+
+  //guarded by lock
+  bool quit;
+  bool running;  //the worker is executing a window
+
+  std::atomic<bool> stop;    //end the window at the next instruction boundary
+  std::atomic<uint16> sfr;   //SFR as of the last completed instruction
+
+  //owned by the emulation thread; clocks is written by the worker while running
+  bool active;     //a window has been started and not joined yet
+  uint64 clocks;   //GSU clocks executed during the window
+  uint64 stepped;  //clocks the cothread advanced on behalf of the worker
+  bool irq;        //STOP raised the IRQ during the window
+} worker;
+
+enum : unsigned { WorkerStep = 1364 };  //one scanline
+
+bool detached;  //GSU code is executing on the worker thread
+
+bool worker_allowed() const;
+void worker_run();
+void worker_join();
+void worker_entry();
+void worker_term();
@@ -25,14 +25,20 @@ void SuperGameBoy::enter() {
       scheduler.exit(Scheduler::ExitReason::SynchronizeEvent);
     }
 
-    unsigned samples = sgb_run(samplebuffer, 16);
+    //the S-CPU only resynchronizes with the Game Boy once per scanline, so there is nothing to gain from
+    //yielding before it is caught up: run the whole distance in one call across the library boundary
+    unsigned slice = 16;
+    if(lag() > 0) slice = max(16u, min(2048u, (unsigned)(lag() / cpu.frequency) + 1));
+
+    unsigned samples = sgb_run(samplebuffer, slice);
     for(unsigned i = 0; i < samples; i++) {
       int16 left  = samplebuffer[i] >>  0;
       int16 right = samplebuffer[i] >> 16;
 
       //SNES audio is notoriously quiet; lower Game Boy samples to match SGB sound effects
-      audio.coprocessor_sample(left / 3, right / 3);
+      samplebuffer[i] = (uint16)(left / 3) | ((uint16)(right / 3) << 16);
     }
+    audio.coprocessor_samples(samplebuffer, samples);
 
     step(samples);
     synchronize_cpu();
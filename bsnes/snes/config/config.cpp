@@ -20,6 +20,8 @@ Configuration::Configuration() {
   ppu1.version = 1;
   ppu2.version = 3;
 
+  superfx.threaded = false;
+
   sat.path = "./bsxdat/";
   sat.local_time = true;
   sat.custom_time = 798653040; // 1995-04-23 16:04
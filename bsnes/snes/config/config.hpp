@@ -25,6 +25,10 @@ struct Configuration {
     unsigned version;
   } ppu2;
 
+  struct SuperFX {
+    bool threaded;  //run the GSU on a host thread while it owns game pak ROM and RAM
+  } superfx;
+
   struct Satellaview {
     string path;
     bool local_time;
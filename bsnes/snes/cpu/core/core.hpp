@@ -209,3 +209,30 @@ public:
   void core_serialize(serializer&);
   CPUcore();
 };
+
+//renders binary trace records back to disassemble_opcode() text, for tools that
+//read trace logs outside of the running system
+class CPUcoreTrace : public CPUcore {
+public:
+  //binary trace logs start with signature, followed by a list of records, each
+  //consisting of a type byte and a payload:
+  //  RecordCPU, RecordSA1: trace_t (trace_t::Size bytes)
+  //  RecordText: 16-bit little-endian length, followed by one line of disassembly
+  static const char signature[8];
+  enum : uint8 { RecordCPU, RecordSA1, RecordText };
+
+  void disassemble(char *output, const trace_t &trace_, bool hclocks = false);
+  bool render(file &output, const uint8 *data, unsigned size, bool hclocks = false);
+
+private:
+  trace_t trace;
+
+  void op_io() {}
+  uint8_t op_read(uint32_t) { return 0; }
+  void op_write(uint32_t, uint8_t) {}
+  void last_cycle() {}
+  bool interrupt_pending() { return false; }
+
+  uint8 disassembler_read(uint32 addr);
+  void disassembler_position(unsigned &vcounter, unsigned &hcounter, unsigned &hdot, unsigned &framecounter);
+};
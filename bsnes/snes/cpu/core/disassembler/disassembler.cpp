@@ -424,11 +424,163 @@ void CPUcore::disassemble_opcode(char *output, uint32 addr, bool hclocks) {
   strcat(s, t);
   strcat(s, " ");
 
+  unsigned vcounter, hcounter, hdot, framecounter;
+  disassembler_position(vcounter, hcounter, hdot, framecounter);
   if (hclocks)
-    sprintf(t, "V:%3d H:%4d F:%2d", cpu.vcounter(), cpu.hcounter(), cpu.framecounter());
+    sprintf(t, "V:%3d H:%4d F:%2d", vcounter, hcounter, framecounter);
   else
-    sprintf(t, "V:%3d H:%3d F:%2d", cpu.vcounter(), cpu.hdot(), cpu.framecounter());
+    sprintf(t, "V:%3d H:%3d F:%2d", vcounter, hdot, framecounter);
   strcat(s, t);
 }
 
+void CPUcore::disassembler_position(unsigned &vcounter, unsigned &hcounter, unsigned &hdot, unsigned &framecounter) {
+  vcounter = cpu.vcounter();
+  hcounter = cpu.hcounter();
+  hdot = cpu.hdot();
+  framecounter = cpu.framecounter();
+}
+
+//returns the bank $00 address of the pointer read by indirect direct page / stack relative
+//opcodes, or ~0 if the opcode does not read one
+uint32 CPUcore::disassemble_pointer(uint8 op, uint8 op8) {
+  switch(op & 0x1f) {
+    case 0x01: return (regs.d + regs.x + op8) & 0xffff;  //(dp,x)
+    case 0x07:                                           //[dp]
+    case 0x11:                                           //(dp),y
+    case 0x12:                                           //(dp)
+    case 0x17: return (regs.d + op8) & 0xffff;           //[dp],y
+    case 0x13: return (regs.s + op8) & 0xffff;           //(sr,s),y
+  }
+  return ~0;
+}
+
+void CPUcore::disassemble_trace(trace_t &trace, uint32 addr) {
+  reg24_t pc;
+  pc.d = addr;
+  trace.pc = addr;
+  for(unsigned n = 0; n < 4; n++) {
+    trace.opcode[n] = dreadb(pc.d);
+    pc.w++;
+  }
+
+  uint32 pointer = disassemble_pointer(trace.opcode[0], trace.opcode[1]);
+  for(unsigned n = 0; n < 3; n++) {
+    trace.pointer[n] = pointer != ~0 ? dreadb(pointer + n) : 0x00;
+  }
+
+  trace.a = regs.a;
+  trace.x = regs.x;
+  trace.y = regs.y;
+  trace.s = regs.s;
+  trace.d = regs.d;
+  trace.db = regs.db;
+  trace.p = regs.p;
+  trace.e = regs.e;
+
+  unsigned vcounter, hcounter, hdot, framecounter;
+  disassembler_position(vcounter, hcounter, hdot, framecounter);
+  trace.vcounter = vcounter;
+  trace.hcounter = hcounter;
+  trace.hdot = hdot;
+  trace.framecounter = framecounter;
+}
+
+void CPUcore::trace_t::store(uint8 *output) const {
+  *output++ = pc >> 0; *output++ = pc >> 8; *output++ = pc >> 16;
+  for(unsigned n = 0; n < 4; n++) *output++ = opcode[n];
+  for(unsigned n = 0; n < 3; n++) *output++ = pointer[n];
+  *output++ = a >> 0; *output++ = a >> 8;
+  *output++ = x >> 0; *output++ = x >> 8;
+  *output++ = y >> 0; *output++ = y >> 8;
+  *output++ = s >> 0; *output++ = s >> 8;
+  *output++ = d >> 0; *output++ = d >> 8;
+  *output++ = db;
+  *output++ = p;
+  *output++ = e;
+  *output++ = vcounter >> 0; *output++ = vcounter >> 8;
+  *output++ = hcounter >> 0; *output++ = hcounter >> 8;
+  *output++ = hdot >> 0; *output++ = hdot >> 8;
+  *output++ = framecounter;
+}
+
+void CPUcore::trace_t::load(const uint8 *input) {
+  pc = input[0] | (input[1] << 8) | (input[2] << 16); input += 3;
+  for(unsigned n = 0; n < 4; n++) opcode[n] = *input++;
+  for(unsigned n = 0; n < 3; n++) pointer[n] = *input++;
+  a = input[0] | (input[1] << 8); input += 2;
+  x = input[0] | (input[1] << 8); input += 2;
+  y = input[0] | (input[1] << 8); input += 2;
+  s = input[0] | (input[1] << 8); input += 2;
+  d = input[0] | (input[1] << 8); input += 2;
+  db = *input++;
+  p = *input++;
+  e = *input++;
+  vcounter = input[0] | (input[1] << 8); input += 2;
+  hcounter = input[0] | (input[1] << 8); input += 2;
+  hdot = input[0] | (input[1] << 8); input += 2;
+  framecounter = *input++;
+}
+
+const char CPUcoreTrace::signature[8] = { 'B', 'S', 'N', 'E', 'S', 'T', 'R', '2' };
+
+//converts a binary trace log into the text log format; returns false if the log is invalid
+bool CPUcoreTrace::render(file &output, const uint8 *data, unsigned size, bool hclocks) {
+  if(size < sizeof signature || memcmp(data, signature, sizeof signature)) return false;
+
+  trace_t record;
+  char text[256];
+  unsigned offset = sizeof signature;
+  while(offset < size) {
+    uint8 type = data[offset++];
+    if(type == RecordCPU || type == RecordSA1) {
+      if(offset + trace_t::Size > size) break;
+      record.load(data + offset);
+      offset += trace_t::Size;
+      disassemble(text, record, hclocks);
+      output.print(text, "\n");
+    } else if(type == RecordText) {
+      if(offset + 2 > size) break;
+      unsigned length = data[offset + 0] | (data[offset + 1] << 8);
+      offset += 2;
+      if(offset + length > size) break;
+      output.write(data + offset, length);
+      output.write('\n');
+      offset += length;
+    } else {
+      break;
+    }
+  }
+  return true;
+}
+
+void CPUcoreTrace::disassemble(char *output, const trace_t &trace_, bool hclocks) {
+  trace = trace_;
+  regs.a = trace.a;
+  regs.x = trace.x;
+  regs.y = trace.y;
+  regs.s = trace.s;
+  regs.d = trace.d;
+  regs.db = trace.db;
+  regs.p = trace.p;
+  regs.e = trace.e;
+  disassemble_opcode(output, trace.pc, hclocks);
+}
+
+uint8 CPUcoreTrace::disassembler_read(uint32 addr) {
+  for(unsigned n = 0; n < 4; n++) {
+    if(addr == ((trace.pc & 0xff0000) | ((trace.pc + n) & 0xffff))) return trace.opcode[n];
+  }
+
+  uint32 pointer = disassemble_pointer(trace.opcode[0], trace.opcode[1]);
+  if(pointer != ~0 && addr - pointer < 3) return trace.pointer[addr - pointer];
+  return 0x00;
+}
+
+void CPUcoreTrace::disassembler_position(unsigned &vcounter, unsigned &hcounter, unsigned &hdot, unsigned &framecounter) {
+  vcounter = trace.vcounter;
+  hcounter = trace.hcounter;
+  hdot = trace.hdot;
+  framecounter = trace.framecounter;
+}
+
 #endif
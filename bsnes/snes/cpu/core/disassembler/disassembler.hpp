@@ -27,3 +27,24 @@ uint8  dreadb(uint32 addr);
 uint16 dreadw(uint32 addr);
 uint32 dreadl(uint32 addr);
 uint32 decode(uint8 offset_type, uint32 addr, uint32 pc);
+
+//compact snapshot of everything disassemble_opcode() reads, for binary trace logs
+struct trace_t {
+  enum : unsigned { Size = 30 };  //bytes written by store()
+
+  uint32 pc;
+  uint8  opcode[4];   //opcode and operand bytes at pc
+  uint8  pointer[3];  //bytes read through an indirect direct page / stack operand
+  uint16 a, x, y, s, d;
+  uint8  db, p;
+  bool   e;
+  uint16 vcounter, hcounter, hdot;
+  uint8  framecounter;
+
+  void store(uint8 *output) const;
+  void load(const uint8 *input);
+};
+
+void   disassemble_trace(trace_t &trace, uint32 addr);
+uint32 disassemble_pointer(uint8 op, uint8 op8);
+virtual void disassembler_position(unsigned &vcounter, unsigned &hcounter, unsigned &hdot, unsigned &framecounter);
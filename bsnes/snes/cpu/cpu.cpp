@@ -19,10 +19,7 @@ namespace SNES {
 void CPU::step(unsigned clocks) {
   smp.clock -= clocks * (uint64)smp.frequency;
   ppu.clock -= clocks;
-  for(unsigned i = 0; i < coprocessors.size(); i++) {
-    Processor &chip = *coprocessors[i];
-    chip.clock -= clocks * (uint64)chip.frequency;
-  }
+  coprocessor_time += clocks;
 }
 
 void CPU::synchronize_smp() {
@@ -41,11 +38,35 @@ void CPU::synchronize_ppu() {
   }
 }
 
+//only resumes chips that are behind; nothing at all is done until the earliest of them falls behind
 void CPU::synchronize_coprocessor() {
+  if(coprocessor_time <= coprocessor_wake) return;
+  for(unsigned i = 0; i < coprocessors.size(); i++) {
+    Processor &chip = *coprocessors[i];
+    if(chip.clock < coprocessor_time * chip.frequency) co_switch(chip.thread);
+  }
+  coprocessor_schedule();
+}
+
+//a chip is behind once coprocessor_time * frequency > clock, that is once coprocessor_time > floor(clock / frequency)
+void CPU::coprocessor_schedule() {
+  coprocessor_wake = INT64_MAX;
+  for(unsigned i = 0; i < coprocessors.size(); i++) {
+    Processor &chip = *coprocessors[i];
+    if(chip.frequency == 0) continue;
+    int64 wake = chip.clock >= 0 ? chip.clock / chip.frequency : -((-chip.clock + chip.frequency - 1) / chip.frequency);
+    coprocessor_wake = min(coprocessor_wake, wake);
+  }
+}
+
+//rebases the timeline to zero, keeping timestamps far from overflow; called once per frame
+void CPU::coprocessor_normalize() {
   for(unsigned i = 0; i < coprocessors.size(); i++) {
     Processor &chip = *coprocessors[i];
-    if(chip.clock < 0) co_switch(chip.thread);
+    chip.clock -= coprocessor_time * chip.frequency;
   }
+  coprocessor_time = 0;
+  coprocessor_schedule();
 }
 
 void CPU::Enter() { cpu.enter(); }
@@ -114,6 +135,8 @@ void CPU::power() {
 void CPU::reset() {
   create(Enter, system.cpu_frequency());
   coprocessors.reset();
+  coprocessor_time = 0;
+  coprocessor_wake = INT64_MIN;  //chips are attached after reset; rescan on the first synchronization
   PPUcounter::reset();
 
   //note: some registers are not fully reset by SNES
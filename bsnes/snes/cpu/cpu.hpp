@@ -7,6 +7,13 @@ public:
   void synchronize_ppu();
   void synchronize_coprocessor();
 
+  //S-CPU clocks since the last normalization; coprocessors keep absolute timestamps against it,
+  //so stepping the S-CPU no longer touches every chip
+  int64 coprocessor_time;
+  int64 coprocessor_wake;  //latest coprocessor_time at which no chip is behind yet; may be early, never late
+  void coprocessor_schedule();
+  void coprocessor_normalize();
+
   uint8 pio();
   bool joylatch();
   alwaysinline bool interrupt_pending() { return status.interrupt_pending; }
@@ -14,6 +14,8 @@ uint8 CPUDebugger::disassembler_read(uint32 addr)
 }
 
 void CPUDebugger::op_step() {
+  if(!debugger.attached) return CPU::op_step();
+
   bool break_event = false;
 
   usage[regs.pc] &= ~(UsageFlagM | UsageFlagX);
@@ -63,6 +65,8 @@ void CPUDebugger::op_step() {
 }
 
 alwaysinline uint8_t CPUDebugger::op_readpc() {
+  if(!debugger.attached) return CPU::op_read((regs.pc.b << 16) + regs.pc.w++);
+
   usage[regs.pc] |= UsageExec;
   
   int offset = cartridge.rom_offset(regs.pc);
@@ -74,6 +78,8 @@ alwaysinline uint8_t CPUDebugger::op_readpc() {
 
 uint8 CPUDebugger::op_read(uint32 addr) {
   uint8 data = CPU::op_read(addr);
+  if(!debugger.attached) return data;
+
   // ignore dummy reads that can be caused by interrupts
   if (!interrupt_pending()) {
     usage[addr] |= UsageRead;
@@ -87,6 +93,8 @@ uint8 CPUDebugger::op_read(uint32 addr) {
 }
 
 uint8 CPUDebugger::dma_read(uint32 abus) {
+  if(!debugger.attached) return CPU::dma_read(abus);
+
   usage[abus] |= UsageRead;
   
   int offset = cartridge.rom_offset(abus);
@@ -98,6 +106,8 @@ uint8 CPUDebugger::dma_read(uint32 abus) {
 }
 
 void CPUDebugger::op_write(uint32 addr, uint8 data) {
+  if(!debugger.attached) return CPU::op_write(addr, data);
+
   debugger.breakpoint_test(Debugger::Breakpoint::Source::CPUBus, Debugger::Breakpoint::Mode::Write, addr, data);
   CPU::op_write(addr, data);
   usage[addr] |= UsageWrite;
@@ -107,7 +117,7 @@ void CPUDebugger::op_write(uint32 addr, uint8 data) {
 // $2180 MMIO-based WRAM access
 #if defined(ALT_CPU_CPP)
 uint8 CPUDebugger::mmio_read(unsigned addr) {
-  if (addr & 0xffff == 0x2180) {
+  if (debugger.attached && addr & 0xffff == 0x2180) {
     uint32 fulladdr = 0x7e0000 | status.wram_addr;
     uint8 data = bus.read(fulladdr);
   
@@ -119,7 +129,7 @@ uint8 CPUDebugger::mmio_read(unsigned addr) {
 }
 
 void CPUDebugger::mmio_write(unsigned addr, uint8 data) {
-  if (addr & 0xffff == 0x2180) {
+  if (debugger.attached && addr & 0xffff == 0x2180) {
     uint32 fulladdr = 0x7e0000 | status.wram_addr;
   
     usage[fulladdr] |= UsageWrite;
@@ -130,6 +140,8 @@ void CPUDebugger::mmio_write(unsigned addr, uint8 data) {
 }
 #else
 uint8 CPUDebugger::mmio_r2180() {
+  if(!debugger.attached) return CPU::mmio_r2180();
+
   uint32 fulladdr = 0x7e0000 | status.wram_addr;
   uint8 data = bus.read(fulladdr);
  
@@ -139,6 +151,8 @@ uint8 CPUDebugger::mmio_r2180() {
 }
 
 void CPUDebugger::mmio_w2180(uint8 data) {
+  if(!debugger.attached) return CPU::mmio_w2180(data);
+
   uint32 fulladdr = 0x7e0000 | status.wram_addr;
  
   usage[fulladdr] |= UsageWrite;
@@ -147,17 +161,10 @@ void CPUDebugger::mmio_w2180(uint8 data) {
 }
 #endif
 
-CPUDebugger::CPUDebugger() {
-  usage = new uint8[1 << 24]();
-  cart_usage = new uint8[1 << 24]();
+CPUDebugger::CPUDebugger() : usage(1 << 24), cart_usage(1 << 24) {
   opcode_pc = 0x8000;
 }
 
-CPUDebugger::~CPUDebugger() {
-  delete[] usage;
-  delete[] cart_usage;
-}
-
 bool CPUDebugger::property(unsigned id, string &name, string &value) {
   unsigned n = 0;
 
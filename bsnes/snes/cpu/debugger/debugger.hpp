@@ -44,8 +44,8 @@ public:
     UsageFlagM  = 0x02,
     UsageFlagX  = 0x01,
   };
-  uint8 *usage;
-  uint8 *cart_usage;
+  UsageMap usage;
+  UsageMap cart_usage;
 #if defined(ALT_CPU_HPP)
   uint8 mmio_read(unsigned addr);
   void mmio_write(unsigned addr, uint8 data);
@@ -69,5 +69,4 @@ public:
   uint8 disassembler_read(uint32 addr);
 
   CPUDebugger();
-  ~CPUDebugger();
 };
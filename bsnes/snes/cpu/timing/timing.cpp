@@ -11,10 +11,41 @@ unsigned CPU::joypad_counter() {
   return clock_counter & 255;
 }
 
+//true when stepping the next clocks one cycle at a time would change nothing but the counters:
+//no scanline edge, NMI edge, H/V IRQ match, pending interrupt hold, active auto joypad poll or light gun latch.
+//the interrupt tests below mirror poll_interrupts() for hcounter >= 10, where every *_past() lookback
+//stays on the current scanline.
+bool CPU::timing_idle(unsigned clocks) {
+  unsigned hcounter = this->hcounter();
+  if(hcounter < 10 || hcounter + clocks >= lineclocks()) return false;
+  if(status.nmi_hold || status.irq_hold) return false;
+  if(input.lightgun()) return false;
+
+  bool vblank = vcounter() >= (ppu.overscan() == false ? 225 : 240);
+  if(status.nmi_valid != vblank) return false;
+  if(vblank && status.auto_joypad_counter <= 16) return false;
+
+  if(status.virq_enabled || status.hirq_enabled) {
+    if(status.irq_line && !status.irq_transition) return false;
+    if(status.irq_valid) return false;
+    if(status.virq_enabled && vcounter() != status.virq_pos) return true;
+    if(!status.hirq_enabled) return false;  //V-IRQ line: irq_valid is about to rise
+    unsigned position = (status.hirq_pos + 1) * 4 + 10;
+    if(position > hcounter && position <= hcounter + clocks) return false;
+    return true;
+  }
+
+  return status.irq_valid == false;
+}
+
 void CPU::add_clocks(unsigned clocks) {
   status.irq_lock = false;
   unsigned ticks = clocks >> 1;
-  while(ticks--) {
+  if(timing_idle(ticks << 1)) {
+    //advance in one step; joypad_edge() would only count cycles here
+    PPUcounter::tick(ticks << 1);
+    if(vcounter() >= (ppu.overscan() == false ? 225 : 240)) status.auto_joypad_counter += ticks;
+  } else while(ticks--) {
     tick();
     if(hcounter() & 2) {
       input.tick();
@@ -49,6 +80,7 @@ void CPU::scanline() {
     status.hdma_init_triggered = false;
     
     status.auto_joypad_counter = 0;
+    coprocessor_normalize();
   }
 
   //DRAM refresh occurs once every scanline
@@ -3,6 +3,7 @@ unsigned dma_counter();
 unsigned joypad_counter();
 
 void add_clocks(unsigned clocks);
+alwaysinline bool timing_idle(unsigned clocks);
 void scanline();
 
 alwaysinline void alu_edge();
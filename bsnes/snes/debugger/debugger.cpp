@@ -2,45 +2,172 @@
 
 Debugger debugger;
 
-void Debugger::breakpoint_test(Debugger::Breakpoint::Source source, Debugger::Breakpoint::Mode mode, unsigned addr, uint8 data) {
-  for(unsigned i = 0; i < Breakpoints; i++) {
-    if(breakpoint[i].enabled == false) continue;
+Debugger::Breakpoint::Breakpoint() {
+  enabled = false;
+  addr = 0;
+  addr_end = 0;
+  data = -1;
+  mode = (unsigned)Mode::Exec;
+  source = Source::CPUBus;
+  counter = 0;
+}
 
-    if(breakpoint[i].data != -1 && breakpoint[i].data != data) continue;
-    if(breakpoint[i].source != source) continue;
-    
-    if((breakpoint[i].mode & (unsigned)mode) == 0) continue;
-    
-    // account for address mirroring on the S-CPU and SA-1 (and other) buses
-    // (with 64kb granularity for ranged breakpoints)
-    unsigned addr_start = (breakpoint[i].addr & 0xff0000) | (addr & 0xffff);
-    if (addr_start < breakpoint[i].addr) {
-      addr_start += 1<<16;
-    }
-    unsigned addr_end = breakpoint[i].addr;
-    if (breakpoint[i].addr_end > breakpoint[i].addr) {
-      addr_end = breakpoint[i].addr_end;
+void Debugger::BreakpointIndex::add(unsigned lo, unsigned hi, unsigned id, unsigned mode) {
+  interval.append({ lo, hi, 0, id });
+  for(unsigned n = lo >> 8; n <= (hi - 1) >> 8; n++) page[n] |= mode;
+}
+
+void Debugger::BreakpointIndex::build() {
+  levels = 0;
+  unsigned size = interval.size();
+  if(size == 0) return;
+  sort(&interval[0], size);
+
+  //leaves are the even indices; the nodes of level k are the indices with exactly k low bits set
+  unsigned last_i, last;
+  for(unsigned i = 0; i < size; i += 2) {
+    last_i = i;
+    last = interval[i].max = interval[i].hi;
+  }
+  unsigned k;
+  for(k = 1; (1u << k) <= size; k++) {
+    unsigned x = 1 << (k - 1), i0 = (x << 1) - 1, step = x << 2;
+    for(unsigned i = i0; i < size; i += step) {
+      unsigned el = interval[i - x].max;
+      unsigned er = i + x < size ? interval[i + x].max : last;
+      interval[i].max = max(interval[i].hi, max(el, er));
     }
-    
-    for (; addr_start <= addr_end; addr_start += 1<<16) {
-      if (source == Debugger::Breakpoint::Source::CPUBus) {
-        if (bus.is_mirror(addr_start, addr)) break;
-      } else if (source == Debugger::Breakpoint::Source::SA1Bus) {
-        if (sa1bus.is_mirror(addr_start, addr)) break;
-      } else if (source == Debugger::Breakpoint::Source::SFXBus) {
-        if (superfxbus.is_mirror(addr_start, addr)) break;
-      } else {
-        if (addr_start == addr) break;
+    last_i = (last_i >> k & 1) ? last_i - x : last_i + x;  //parent of the rightmost node
+    if(last_i < size && interval[last_i].max > last) last = interval[last_i].max;
+  }
+  levels = k - 1;
+}
+
+//returns the lowest-numbered breakpoint whose range contains addr and whose mode and data match
+unsigned Debugger::BreakpointIndex::find(unsigned addr, unsigned mode, uint8 data, const linear_vector<Breakpoint> &breakpoint) const {
+  unsigned size = interval.size();
+  unsigned result = ~0;
+  if(size == 0) return result;
+
+  auto test = [&](unsigned i) {
+    const Breakpoint &bp = breakpoint[interval[i].id];
+    if((bp.mode & mode) && (bp.data == -1 || bp.data == data)) result = min(result, interval[i].id);
+  };
+
+  struct { unsigned k, x; bool right; } stack[64];
+  unsigned t = 0;
+  stack[t++] = { levels, (1u << levels) - 1, false };
+  while(t) {
+    auto z = stack[--t];
+    if(z.k <= 3) {
+      //small subtree: scan it linearly
+      unsigned i0 = z.x >> z.k << z.k;
+      unsigned i1 = min(i0 + (1u << (z.k + 1)) - 1, size);
+      for(unsigned i = i0; i < i1 && interval[i].lo <= addr; i++) {
+        if(addr < interval[i].hi) test(i);
       }
+    } else if(!z.right) {
+      unsigned y = z.x - (1u << (z.k - 1));  //left child
+      stack[t++] = { z.k, z.x, true };
+      if(y >= size || interval[y].max > addr) stack[t++] = { z.k - 1, y, false };
+    } else if(z.x < size && interval[z.x].lo <= addr) {
+      if(addr < interval[z.x].hi) test(z.x);
+      stack[t++] = { z.k - 1, z.x + (1u << (z.k - 1)), false };  //right child
     }
-    if (addr_start > addr_end) continue;
-    
-    breakpoint[i].counter++;
-    breakpoint_hit = i;
-    break_event = BreakEvent::BreakpointHit;
-    scheduler.exit(Scheduler::ExitReason::DebuggerEvent);
-    break;
   }
+  return result;
+}
+
+//adds [lo, hi] on the given bus, plus every address in another bank that maps to the same memory
+void Debugger::breakpoint_mirror(BreakpointIndex &index, Bus &bus, unsigned lo, unsigned hi, unsigned id, unsigned mode) {
+  linear_vector<BreakpointIndex::Interval> list;
+  uint8 *covered = new uint8[1 << 16]();  //pages already added in full, along with their mirrors
+  for(unsigned n = lo >> 8; n <= hi >> 8; n++) {
+    unsigned start = max(lo, n << 8) & 0xff;
+    unsigned end = min(hi, (n << 8) | 0xff) & 0xff;
+    bool full = start == 0x00 && end == 0xff;
+    if(full && covered[n]) continue;
+
+    const Bus::Page &target = bus.page[n];
+    for(unsigned bank = 0; bank < 256; bank++) {
+      unsigned p = (bank << 8) | (n & 0xff);
+      if(bus.page[p].access != target.access) continue;
+      if(bus.page[p].offset + (p << 8) != target.offset + (n << 8)) continue;
+      list.append({ (p << 8) | start, ((p << 8) | end) + 1, 0, id });
+      if(full) covered[p] = true;
+    }
+  }
+  delete[] covered;
+  if(list.size() == 0) return;
+
+  //merge ranges that became contiguous, so large ranges stay a handful of intervals
+  sort(&list[0], list.size());
+  unsigned merged = 0;
+  for(unsigned i = 1; i < list.size(); i++) {
+    if(list[i].lo <= list[merged].hi) list[merged].hi = max(list[merged].hi, list[i].hi);
+    else list[++merged] = list[i];
+  }
+  for(unsigned i = 0; i <= merged; i++) index.add(list[i].lo, list[i].hi, id, mode);
+}
+
+void Debugger::breakpoint_update() {
+  for(unsigned s = 0; s < Breakpoint::Sources; s++) {
+    memset(breakpoint_index[s].page, 0, breakpoint_index[s].pages);
+    breakpoint_index[s].interval.reset();
+  }
+
+  for(unsigned id = 0; id < breakpoint.size(); id++) {
+    const Breakpoint &bp = breakpoint[id];
+    if(bp.enabled == false || bp.mode == 0) continue;
+
+    BreakpointIndex &index = breakpoint_index[(unsigned)bp.source];
+    unsigned lo = bp.addr;
+    unsigned hi = max(bp.addr, bp.addr_end);
+    unsigned limit = index.pages << 8;
+    if(lo >= limit) continue;
+    hi = min(hi, limit - 1);
+
+    switch(bp.source) {
+      case Breakpoint::Source::CPUBus: breakpoint_mirror(index, bus, lo, hi, id, bp.mode); break;
+      case Breakpoint::Source::SA1Bus: breakpoint_mirror(index, sa1bus, lo, hi, id, bp.mode); break;
+      case Breakpoint::Source::SFXBus: breakpoint_mirror(index, superfxbus, lo, hi, id, bp.mode); break;
+      default: index.add(lo, hi + 1, id, bp.mode); break;
+    }
+  }
+
+  for(unsigned s = 0; s < Breakpoint::Sources; s++) breakpoint_index[s].build();
+  breakpoint_remapped = false;
+}
+
+//called when a bus page is remapped, which may invalidate resolved mirrors. until the index is
+//rebuilt, every access to a bus with breakpoints on it takes the slow path, which rebuilds first.
+void Debugger::breakpoint_remap() {
+  if(breakpoint_remapped) return;
+  static const Breakpoint::Source buses[] = {
+    Breakpoint::Source::CPUBus, Breakpoint::Source::SA1Bus, Breakpoint::Source::SFXBus,
+  };
+  foreach(source, buses) {
+    BreakpointIndex &index = breakpoint_index[(unsigned)source];
+    if(index.interval.size() == 0) continue;
+    memset(index.page, 0xff, index.pages);
+    breakpoint_remapped = true;
+  }
+}
+
+void Debugger::breakpoint_match(Debugger::Breakpoint::Source source, Debugger::Breakpoint::Mode mode, unsigned addr, uint8 data) {
+  BreakpointIndex &index = breakpoint_index[(unsigned)source];
+  if(breakpoint_remapped) {
+    breakpoint_update();
+    if(!(index.page[addr >> 8] & (unsigned)mode)) return;
+  }
+
+  unsigned id = index.find(addr, (unsigned)mode, data, breakpoint);
+  if(id == ~0u) return;
+
+  breakpoint[id].counter++;
+  breakpoint_hit = id;
+  break_event = BreakEvent::BreakpointHit;
+  scheduler.exit(Scheduler::ExitReason::DebuggerEvent);
 }
 
 uint8 Debugger::read(Debugger::MemorySource source, unsigned addr) {
@@ -142,15 +269,16 @@ void Debugger::write(Debugger::MemorySource source, unsigned addr, uint8 data) {
 Debugger::Debugger() {
   break_event = BreakEvent::None;
 
-  for(unsigned n = 0; n < Breakpoints; n++) {
-    breakpoint[n].enabled = false;
-    breakpoint[n].addr = 0;
-    breakpoint[n].data = -1;
-    breakpoint[n].mode = (unsigned)Breakpoint::Mode::Exec;
-    breakpoint[n].source = Breakpoint::Source::CPUBus;
-    breakpoint[n].counter = 0;
+  for(unsigned s = 0; s < Breakpoint::Sources; s++) {
+    bool bus = s == (unsigned)Breakpoint::Source::CPUBus
+            || s == (unsigned)Breakpoint::Source::SA1Bus
+            || s == (unsigned)Breakpoint::Source::SFXBus;
+    breakpoint_index[s].pages = bus ? 1 << 16 : 1 << 8;
+    breakpoint_index[s].page = new uint8[breakpoint_index[s].pages]();
+    breakpoint_index[s].levels = 0;
   }
   breakpoint_hit = 0;
+  breakpoint_remapped = false;
 
   step_cpu = false;
   step_smp = false;
@@ -158,8 +286,13 @@ Debugger::Debugger() {
   step_sfx = false;
   bus_access = false;
   break_on_wdm = false;
+  attached = false;
   
   step_type = StepType::None;
 }
 
+Debugger::~Debugger() {
+  for(unsigned s = 0; s < Breakpoint::Sources; s++) delete[] breakpoint_index[s].page;
+}
+
 #endif
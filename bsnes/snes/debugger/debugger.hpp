@@ -9,9 +9,8 @@ public:
     SFXStep,
   } break_event;
 
-  enum { Breakpoints = 8,
-         SoftBreakCPU = Breakpoints,
-         SoftBreakSA1, };
+  enum : unsigned { SoftBreakCPU = 0x80000000,
+                    SoftBreakSA1, };
   struct Breakpoint {
     bool enabled;
     unsigned addr;
@@ -22,10 +21,20 @@ public:
     unsigned mode;
     
     enum class Source : unsigned { CPUBus, APURAM, VRAM, OAM, CGRAM, SA1Bus, SFXBus } source;
+    enum { Sources = 7 };
     unsigned counter;  //number of times breakpoint has been hit since being set
-  } breakpoint[Breakpoints];
+
+    Breakpoint();
+  };
+  linear_vector<Breakpoint> breakpoint;  //call breakpoint_update() after modifying
   unsigned breakpoint_hit;
-  void breakpoint_test(Breakpoint::Source source, Breakpoint::Mode mode, unsigned addr, uint8 data);
+  void breakpoint_update();
+  void breakpoint_remap();
+
+  //the common case (no breakpoint anywhere near addr) costs a single bit test
+  alwaysinline void breakpoint_test(Breakpoint::Source source, Breakpoint::Mode mode, unsigned addr, uint8 data) {
+    if(breakpoint_index[(unsigned)source].page[addr >> 8] & (unsigned)mode) breakpoint_match(source, mode, addr, data);
+  }
 
   bool step_cpu;
   bool step_smp;
@@ -34,6 +43,10 @@ public:
   bool bus_access;
   bool break_on_wdm;
 
+  //set by the frontend while any debugging tool needs the chips instrumented;
+  //when cleared, the debugger hooks forward straight to the emulation cores
+  bool attached;
+
   enum class StepType : unsigned { 
     None, StepInto, StepOver, StepOut 
   } step_type;
@@ -45,6 +58,35 @@ public:
   void write(MemorySource, unsigned addr, uint8 data);
 
   Debugger();
+  ~Debugger();
+
+private:
+  //enabled breakpoints are compiled into one index per source: a Breakpoint::Mode mask for
+  //each 256-byte page, and an implicit interval tree (intervals sorted by lo, with max holding
+  //the highest hi of each subtree) of the exact address ranges. bus mirrors are resolved when
+  //the index is built, so each mirrored range is stored as its own interval.
+  struct BreakpointIndex {
+    struct Interval {
+      unsigned lo, hi;  //[lo, hi)
+      unsigned max;
+      unsigned id;
+      bool operator<(const Interval &source) const {
+        return lo < source.lo || (lo == source.lo && id < source.id);
+      }
+    };
+    uint8 *page;
+    unsigned pages;
+    linear_vector<Interval> interval;
+    unsigned levels;
+
+    void add(unsigned lo, unsigned hi, unsigned id, unsigned mode);
+    void build();
+    unsigned find(unsigned addr, unsigned mode, uint8 data, const linear_vector<Breakpoint> &breakpoint) const;
+  } breakpoint_index[Breakpoint::Sources];
+  bool breakpoint_remapped;
+
+  void breakpoint_match(Breakpoint::Source source, Breakpoint::Mode mode, unsigned addr, uint8 data);
+  void breakpoint_mirror(BreakpointIndex &index, Bus &bus, unsigned lo, unsigned hi, unsigned id, unsigned mode);
 };
 
 extern Debugger debugger;
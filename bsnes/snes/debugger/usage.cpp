@@ -0,0 +1,63 @@
+#ifdef SYSTEM_CPP
+
+unsigned UsageMap::size() const {
+  return pages << PageBits;
+}
+
+void UsageMap::reset() {
+  for(unsigned n = 0; n < pages; n++) {
+    delete[] page[n];
+    page[n] = 0;
+  }
+}
+
+//format: number of allocated pages, followed by each page's index and contents
+void UsageMap::load(file &fp) {
+  reset();
+  unsigned count = fp.readl(4);
+  while(count-- && !fp.end()) {
+    unsigned n = fp.readl(4);
+    if(n >= pages || page[n]) break;  //out of range or duplicate: the file is corrupt
+    page[n] = new uint8[PageSize];
+    fp.read(page[n], PageSize);
+  }
+}
+
+//reads a flat, fully populated table, only allocating the pages that contain any flags
+void UsageMap::load_raw(file &fp, unsigned length) {
+  reset();
+  uint8 data[PageSize];
+  for(unsigned n = 0; n < pages && (n << PageBits) < length; n++) {
+    fp.read(data, PageSize);
+    for(unsigned i = 0; i < PageSize; i++) {
+      if(data[i] == 0) continue;
+      page[n] = new uint8[PageSize];
+      memcpy(page[n], data, PageSize);
+      break;
+    }
+  }
+}
+
+void UsageMap::save(file &fp) const {
+  unsigned count = 0;
+  for(unsigned n = 0; n < pages; n++) count += page[n] != 0;
+
+  fp.writel(count, 4);
+  for(unsigned n = 0; n < pages; n++) {
+    if(!page[n]) continue;
+    fp.writel(n, 4);
+    fp.write(page[n], PageSize);
+  }
+}
+
+UsageMap::UsageMap(unsigned size) {
+  pages = size >> PageBits;
+  page = new uint8*[pages]();
+}
+
+UsageMap::~UsageMap() {
+  reset();
+  delete[] page;
+}
+
+#endif
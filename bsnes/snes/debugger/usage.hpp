@@ -0,0 +1,37 @@
+//sparse per-address usage flags (read, write, exec, ...) recorded by the chip debuggers.
+//storage is allocated in 4KB pages on first write, so address space a game never touches costs
+//only a null pointer; read() and allocated() never allocate.
+
+class UsageMap {
+public:
+  enum : unsigned { PageBits = 12, PageSize = 1 << PageBits };
+
+  alwaysinline uint8& operator[](unsigned addr) {
+    uint8 *&data = page[addr >> PageBits];
+    if(!data) data = new uint8[PageSize]();
+    return data[addr & (PageSize - 1)];
+  }
+
+  inline uint8 read(unsigned addr) const {
+    const uint8 *data = page[addr >> PageBits];
+    return data ? data[addr & (PageSize - 1)] : 0;
+  }
+
+  inline bool allocated(unsigned addr) const {
+    return page[addr >> PageBits];
+  }
+
+  unsigned size() const;
+  void reset();
+
+  void load(file &fp);
+  void load_raw(file &fp, unsigned length);
+  void save(file &fp) const;
+
+  UsageMap(unsigned size);
+  ~UsageMap();
+
+private:
+  uint8 **page;
+  unsigned pages;
+};
@@ -332,6 +332,8 @@ void Input::port_set_device(bool portnumber, Device device) {
 }
 
 void Input::poll() {
+  system.interface->input_latch();
+
   for(unsigned i = 0; i < 2; i++) {
     port[i].counter0 = 0;
     port[i].counter1 = 0;
@@ -46,6 +46,9 @@ public:
     }
   }
 
+  //true when tick() may latch the PPU counters, so it must run at every cycle
+  alwaysinline bool lightgun() const { return iobit; }
+
 private:
   bool iobit;
   int16_t latchx, latchy;
@@ -130,6 +130,8 @@ void Bus::map(
       }
     } break;
   }
+
+  debugger.breakpoint_remap();
 }
 
 bool Bus::load_cart() {
@@ -1,6 +1,8 @@
 #ifdef SMP_CPP
 
 void SMPDebugger::op_step() {
+  if(!debugger.attached) return SMP::op_step();
+
   bool break_event = false;
 
   usage[regs.pc] |= UsageOpcode;
@@ -40,6 +42,8 @@ void SMPDebugger::op_step() {
 }
 
 alwaysinline uint8_t SMPDebugger::op_readpc() {
+  if(!debugger.attached) return SMP::op_read(regs.pc++);
+
   usage[regs.pc] |= UsageExec;
   // execute code without setting read flag
   return SMP::op_read(regs.pc++);
@@ -47,27 +51,26 @@ alwaysinline uint8_t SMPDebugger::op_readpc() {
 
 uint8 SMPDebugger::op_read(uint16 addr) {
   uint8 data = SMP::op_read(addr);
+  if(!debugger.attached) return data;
+
   usage[addr] |= UsageRead;
   debugger.breakpoint_test(Debugger::Breakpoint::Source::APURAM, Debugger::Breakpoint::Mode::Read, addr, data);
   return data;
 }
 
 void SMPDebugger::op_write(uint16 addr, uint8 data) {
+  if(!debugger.attached) return SMP::op_write(addr, data);
+
   debugger.breakpoint_test(Debugger::Breakpoint::Source::APURAM, Debugger::Breakpoint::Mode::Write, addr, data);
   SMP::op_write(addr, data);
   usage[addr] |= UsageWrite;
   usage[addr] &= ~UsageExec;
 }
 
-SMPDebugger::SMPDebugger() {
-  usage = new uint8[1 << 16]();
+SMPDebugger::SMPDebugger() : usage(1 << 16) {
   opcode_pc = 0xffc0;
 }
 
-SMPDebugger::~SMPDebugger() {
-  delete[] usage;
-}
-
 static string clockdivide(double base, unsigned divide) {
   if (!divide) divide = 256;
   return string(fp(base / divide), " Hz");
@@ -35,7 +35,7 @@ public:
     UsageExec   = 0x20,
     UsageOpcode = 0x10,
   };
-  uint8 *usage;
+  UsageMap usage;
   uint16 opcode_pc;
 
   void op_step();
@@ -44,5 +44,4 @@ public:
   void op_write(uint16 addr, uint8 data);
 
   SMPDebugger();
-  ~SMPDebugger();
 };
@@ -3,7 +3,7 @@ namespace SNES {
     static const char Name[] = "bsnes-plus";
     static const char Version[] = "04";
     static const unsigned SerializerSignature = 0x43545342; //'BSTC'
-    static const unsigned SerializerVersion = 14;
+    static const unsigned SerializerVersion = 15;
   }
 }
 
@@ -27,6 +27,7 @@ namespace SNES {
 #include <nall/property.hpp>
 #include <nall/random.hpp>
 #include <nall/serializer.hpp>
+#include <nall/sort.hpp>
 #include <nall/stdint.hpp>
 #include <nall/string.hpp>
 #include <nall/utility.hpp>
@@ -34,6 +35,11 @@ namespace SNES {
 #include <nall/vector.hpp>
 using namespace nall;
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #ifdef DEBUGGER
   #define debugvirtual virtual
 #else
@@ -120,6 +126,8 @@ namespace SNES {
     virtual void     setFlag(unsigned id, bool value) {}
   };
 
+  #include <debugger/usage.hpp>
+
   #include <memory/memory.hpp>
   #include <cpu/core/core.hpp>
   #include <smp/core/core.hpp>
@@ -7,6 +7,7 @@ System system;
 
 #include <config/config.cpp>
 #include <debugger/debugger.cpp>
+#include <debugger/usage.cpp>
 #include <scheduler/scheduler.cpp>
 
 #include <video/video.cpp>
@@ -26,6 +27,20 @@ void System::run() {
   }
 }
 
+//runs only the S-SMP and S-DSP for at least the given number of 32khz samples, for SPC playback;
+//the calling thread stands in for the S-CPU, so neither it nor the PPU are ever scheduled
+void System::runapu(unsigned samples) {
+  cothread_t cputhread = cpu.thread;
+  cpu.thread = co_active();
+  scheduler.host_thread = co_active();
+  scheduler.sync = Scheduler::SynchronizeMode::None;
+
+  smp.clock -= (int64)samples * 768 * cpu.frequency;
+  while(smp.clock < 0) co_switch(smp.thread);
+
+  cpu.thread = cputhread;
+}
+
 void System::runtosave() {
   if(CPU::Threaded == true) {
     scheduler.sync = Scheduler::SynchronizeMode::CPU;
@@ -169,6 +184,9 @@ void System::power() {
 
   scheduler.init();
 
+  //the Game Boy state size is only known once its cartridge is running
+  if(cartridge.mode() == Cartridge::Mode::SuperGameBoy) serialize_init();
+
   input.update();
 //video.update();
 }
@@ -220,6 +238,7 @@ void System::unload() {
   bsxbase.unload();
   if(cartridge.mode() == Cartridge::Mode::SuperGameBoy) supergameboy.unload();
   
+  if(cartridge.has_superfx()) superfx.unload();
   if(cartridge.has_msu1()) msu1.unload();
 }
 
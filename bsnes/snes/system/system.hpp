@@ -7,6 +7,7 @@ public:
 
   void run();
   void runtosave();
+  void runapu(unsigned samples);
 
   void init(Interface*);
   void term();
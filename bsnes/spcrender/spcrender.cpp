@@ -0,0 +1,223 @@
+//spcrender: headless batch renderer from SPC and SNSF rips to WAV
+//
+//SPC dumps are loaded straight into the S-SMP and S-DSP, which then run alone as fast as possible;
+//the S-CPU and PPU are never scheduled. SNSF rips are programs for the whole console, so they run
+//complete frames instead, with video output discarded.
+//the emulation core is a single global instance, so each file is rendered in its own worker process.
+
+#include <snes.hpp>
+#include <nall/snes/cartridge.hpp>
+#include "../../snesmusic/snesmusic.hpp"
+
+#include <chrono>
+#include <thread>
+#if !defined(_WIN32)
+  #include <sys/mman.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
+struct Result {
+  bool done;
+  bool spc;
+  unsigned frequency;
+  unsigned samples;
+  double elapsed;  //seconds of wall-clock time spent emulating
+};
+
+struct Renderer : SNES::Interface {
+  int16_t *buffer;
+  unsigned length;  //stereo samples wanted
+  unsigned count;   //stereo samples received
+
+  void audio_sample(uint16_t left, uint16_t right) {
+    if(count >= length) return;
+    buffer[count * 2 + 0] = left;
+    buffer[count * 2 + 1] = right;
+    count++;
+  }
+
+  void message(const string &text) {}
+} renderer;
+
+static unsigned defaultLength = 180;
+static string outputPath;
+
+static double timestamp() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool writeWave(const string &filename, const int16_t *data, unsigned samples, unsigned frequency) {
+  file fp;
+  if(fp.open(filename, file::mode::write) == false) return false;
+  unsigned size = samples * 4;
+
+  fp.write((const uint8_t*)"RIFF", 4);
+  fp.writel(36 + size, 4);
+  fp.write((const uint8_t*)"WAVE", 4);
+  fp.write((const uint8_t*)"fmt ", 4);
+  fp.writel(16, 4);
+  fp.writel(1, 2);  //PCM
+  fp.writel(2, 2);  //channels
+  fp.writel(frequency, 4);
+  fp.writel(frequency * 4, 4);
+  fp.writel(4, 2);  //block alignment
+  fp.writel(16, 2);  //bits per sample
+  fp.write((const uint8_t*)"data", 4);
+  fp.writel(size, 4);
+  for(unsigned n = 0; n < samples * 2; n++) fp.writel((uint16_t)data[n], 2);
+
+  fp.close();
+  return true;
+}
+
+static void render(const char *filename, Result &result) {
+  string name = filename;
+  uint8_t *dump = new uint8_t[0x10000 + 128];
+  uint16_t pc;
+  uint8_t regs[4];
+  uint8_t p;
+  uint8_t *data = 0;
+  unsigned size = 0;
+
+  if(snesmusic_load_spc(name, dump, pc, regs, p)) {
+    const char *dummyCart = "<?xml version='1.0' encoding='UTF-8'?><cartridge region='NTSC' />";
+    SNES::cartridge.load(SNES::Cartridge::Mode::Normal, lstring() << dummyCart);
+    SNES::system.power();
+    SNES::smp.load_dump(dump, pc, regs, p);
+    result.spc = true;
+  } else if(snesmusic_load_snsf(name, data, size)) {
+    SNES::memory::cartrom.copy(data, size);
+    SNES::cartridge.load(SNES::Cartridge::Mode::Normal, lstring() << SNESCartridge(data, size).xmlMemoryMap);
+    SNES::system.power();
+    delete[] data;
+  } else {
+    delete[] dump;
+    return;
+  }
+  delete[] dump;
+
+  unsigned frequency = result.frequency = SNES::system.apu_frequency() / 768;
+  unsigned seconds = snesmusic_length();
+  if(seconds == 0) seconds = defaultLength;
+  renderer.length = seconds * frequency;
+  renderer.count = 0;
+  renderer.buffer = new int16_t[renderer.length * 2];
+
+  double start = timestamp();
+  while(renderer.count < renderer.length) {
+    if(result.spc) SNES::system.runapu(renderer.length - renderer.count);
+    else SNES::system.run();
+  }
+  result.elapsed = timestamp() - start;
+
+  string output = outputPath != "" ? string() << outputPath << notdir(nall::basename(name)) : nall::basename(name);
+  output << ".wav";
+  if(writeWave(output, renderer.buffer, renderer.count, frequency)) {
+    result.samples = renderer.count;
+    result.done = true;
+  }
+
+  delete[] renderer.buffer;
+  SNES::cartridge.unload();
+}
+
+static void report(const char *filename, const Result &result) {
+  if(result.done == false) {
+    printf("failed                           %s\n", filename);
+  } else {
+    double audio = result.samples / (double)result.frequency;
+    printf("%s  %4u:%02u  %7.2fs  %7.1fx  %s\n", result.spc ? "spc " : "snsf",
+      (unsigned)audio / 60, (unsigned)audio % 60, result.elapsed, audio / max(result.elapsed, 0.001), filename);
+  }
+  fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+  unsigned jobs = max(1u, std::thread::hardware_concurrency());
+  lstring files;
+
+  for(int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if(arg == "-j" && i + 1 < argc) jobs = max(1u, (unsigned)decimal(argv[++i]));
+    else if(arg == "-l" && i + 1 < argc) defaultLength = max(1u, (unsigned)decimal(argv[++i]));
+    else if(arg == "-o" && i + 1 < argc) outputPath = argv[++i];
+    else if(arg.beginswith("-")) { files.reset(); break; }
+    else files.append(arg);
+  }
+
+  if(files.size() == 0) {
+    printf("usage: spcrender [-j jobs] [-l seconds] [-o directory] file.spc|file.snsf ...\n");
+    printf("  -j  number of files rendered in parallel (default: %u)\n", jobs);
+    printf("  -l  length of files without a length tag, in seconds (default: %u)\n", defaultLength);
+    printf("  -o  directory for the .wav files (default: next to each input)\n");
+    return 1;
+  }
+  if(outputPath != "" && strend(outputPath, "/") == false) outputPath << "/";
+
+  SNES::config.random = false;
+  SNES::system.init(&renderer);
+
+  unsigned count = files.size();
+  double start = timestamp();
+
+  #if !defined(_WIN32)
+  //results are written by the workers into memory shared with this process
+  Result *results = (Result*)mmap(0, count * sizeof(Result), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if(results == MAP_FAILED) return 1;
+  memset(results, 0, count * sizeof(Result));
+
+  array<pid_t> workers;
+  array<unsigned> indices;
+  unsigned next = 0;
+  while(next < count || workers.size()) {
+    while(workers.size() < jobs && next < count) {
+      pid_t pid = fork();
+      if(pid == 0) {
+        render(files[next], results[next]);
+        _exit(0);
+      }
+      if(pid < 0) {
+        report(files[next], results[next]);
+        next++;
+        continue;
+      }
+      workers.append(pid);
+      indices.append(next++);
+    }
+
+    pid_t pid = wait(0);
+    if(pid < 0) break;
+    for(unsigned n = 0; n < workers.size(); n++) {
+      if(workers[n] != pid) continue;
+      report(files[indices[n]], results[indices[n]]);
+      workers.remove(n);
+      indices.remove(n);
+      break;
+    }
+  }
+  #else
+  Result *results = new Result[count];
+  memset(results, 0, count * sizeof(Result));
+  jobs = 1;
+  for(unsigned n = 0; n < count; n++) {
+    render(files[n], results[n]);
+    report(files[n], results[n]);
+  }
+  #endif
+
+  double elapsed = timestamp() - start;
+  unsigned rendered = 0;
+  double audio = 0, busy = 0;
+  for(unsigned n = 0; n < count; n++) {
+    if(results[n].done == false) continue;
+    rendered++;
+    audio += results[n].samples / (double)results[n].frequency;
+    busy += results[n].elapsed;
+  }
+
+  printf("\n%u of %u files rendered, %u jobs\n", rendered, count, jobs);
+  printf("%.1f minutes of audio in %.2fs: %.1fx realtime overall, %.1fx per job\n",
+    audio / 60, elapsed, audio / max(elapsed, 0.001), audio / max(busy, 0.001));
+  return rendered == count ? 0 : 1;
+}
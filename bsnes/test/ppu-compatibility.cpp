@@ -0,0 +1,222 @@
+//checks the compatibility PPU's span-filled window tables and vectorized color math
+//against straightforward per-pixel implementations of the same logic.
+//the PPU is compiled into this program so that its inline render functions are visible.
+
+#include "../snes/alt/ppu-compatibility/ppu.cpp"
+
+using namespace SNES;
+
+static unsigned failures = 0;
+
+static uint32 random_state = 0x12345678;
+static uint32 random_next() {
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 17;
+  random_state ^= random_state << 5;
+  return random_state;
+}
+
+//window table of one layer and screen, evaluated independently for every pixel
+static void reference_window_table(uint8 bg, bool screen, uint8 *table) {
+  PPU &p = ppu;
+  bool set = 1, clr = 0;
+
+  if(bg != PPU::COL) {
+    if(screen == 0 && p.regs.window_enabled[bg] == false) { memset(table, 0, 256); return; }
+    if(screen == 1 && p.regs.sub_window_enabled[bg] == false) { memset(table, 0, 256); return; }
+  } else {
+    switch(screen == 0 ? p.regs.color_mask : p.regs.colorsub_mask) {
+      case 0: memset(table, 1, 256); return;
+      case 3: memset(table, 0, 256); return;
+      case 1: set = 1, clr = 0; break;
+      case 2: set = 0, clr = 1; break;
+    }
+  }
+
+  for(unsigned x = 0; x < 256; x++) {
+    bool w1 = p.regs.window1_enabled[bg];
+    bool w2 = p.regs.window2_enabled[bg];
+    bool w1_mask = (x >= p.regs.window1_left && x <= p.regs.window1_right) ^ p.regs.window1_invert[bg];
+    bool w2_mask = (x >= p.regs.window2_left && x <= p.regs.window2_right) ^ p.regs.window2_invert[bg];
+
+    bool mask;
+    if(!w1 && !w2) mask = false;
+    else if(w1 && !w2) mask = w1_mask;
+    else if(!w1 && w2) mask = w2_mask;
+    else switch(p.regs.window_mask[bg]) {
+      case 0: mask = (w1_mask | w2_mask) == 1; break;
+      case 1: mask = (w1_mask & w2_mask) == 1; break;
+      case 2: mask = (w1_mask ^ w2_mask) == 1; break;
+      case 3: mask = (w1_mask ^ w2_mask) == 0; break;
+    }
+    table[x] = mask ? set : clr;
+  }
+}
+
+static void test_window_tables() {
+  static const uint8 positions[] = { 0, 1, 127, 128, 200, 254, 255 };
+  enum { Positions = sizeof positions };
+  unsigned checked = 0;
+  uint8 expected[256];
+
+  for(unsigned bg = 0; bg < 6; bg++) {
+    for(unsigned flags = 0; flags < 256; flags++) {
+      ppu.regs.window1_enabled[bg] = flags & 1;
+      ppu.regs.window2_enabled[bg] = flags & 2;
+      ppu.regs.window1_invert[bg]  = flags & 4;
+      ppu.regs.window2_invert[bg]  = flags & 8;
+      ppu.regs.window_mask[bg]     = (flags >> 4) & 3;
+      if(bg != PPU::COL) {
+        ppu.regs.window_enabled[bg]     = flags & 0x40;
+        ppu.regs.sub_window_enabled[bg] = flags & 0x80;
+      } else {
+        ppu.regs.color_mask    = (flags >> 6) & 3;
+        ppu.regs.colorsub_mask = ((flags >> 6) + 1) & 3;
+      }
+
+      for(unsigned n = 0; n < Positions * Positions * Positions * Positions; n++) {
+        ppu.regs.window1_left  = positions[n % Positions];
+        ppu.regs.window1_right = positions[n / Positions % Positions];
+        ppu.regs.window2_left  = positions[n / (Positions * Positions) % Positions];
+        ppu.regs.window2_right = positions[n / (Positions * Positions * Positions)];
+        ppu.build_window_tables(bg);
+
+        for(unsigned screen = 0; screen < 2; screen++) {
+          reference_window_table(bg, screen, expected);
+          const uint8 *table = screen == 0 ? ppu.window[bg].main : ppu.window[bg].sub;
+          if(memcmp(table, expected, 256) && failures++ < 10) {
+            printf("window table mismatch: bg=%u screen=%u flags=%02x windows=%u-%u,%u-%u\n", bg, screen, flags,
+              ppu.regs.window1_left, ppu.regs.window1_right, ppu.regs.window2_left, ppu.regs.window2_right);
+          }
+          checked++;
+        }
+      }
+    }
+  }
+  printf("window tables: %u checked\n", checked);
+}
+
+//compose_math() against addsub() for every pair of bgr555 colors, in every combination
+//of add/sub, halving and color math enable
+static void test_color_math() {
+  uint16 output[256];
+  uint64 checked = 0;
+
+  for(unsigned mode = 0; mode < 2; mode++) {
+    ppu.regs.color_mode = mode;
+    for(unsigned halve = 0; halve < 2; halve++) {
+      for(unsigned x = 0; x < 256; x++) {
+        ppu.compose.math[x]  = (x & 31) == 31 ? 0x0000 : 0xffff;
+        ppu.compose.halve[x] = halve ? 0xffff : 0x0000;
+      }
+
+      for(unsigned a = 0; a < 0x8000; a++) {
+        for(unsigned x = 0; x < 256; x++) ppu.compose.main[x] = a;
+        for(unsigned block = 0; block < 0x8000; block += 256) {
+          for(unsigned x = 0; x < 256; x++) ppu.compose.sub[x] = block + x;
+          ppu.compose_math(output);
+
+          for(unsigned x = 0; x < 256; x++) {
+            uint16 expected = ppu.compose.math[x] ? ppu.addsub(a, block + x, halve) : a;
+            if(output[x] != expected && failures++ < 10) {
+              printf("color math mismatch: mode=%u halve=%u %04x %04x = %04x, expected %04x\n",
+                mode, halve, a, block + x, output[x], expected);
+            }
+          }
+          checked += 256;
+        }
+      }
+    }
+  }
+  printf("color math: %llu pixels checked\n", (unsigned long long)checked);
+}
+
+//one output pixel with color window clipping and color math resolved per pixel;
+//swap = true composites the subscreen as the main source
+static uint16 reference_pixel(unsigned x, bool swap) {
+  PPU &p = ppu;
+  const PPU::pixel_t &pixel = p.pixel_cache[x];
+  uint16 src_main = !swap ? pixel.src_main : pixel.src_sub;
+  uint16 src_sub  = !swap ? pixel.src_sub  : pixel.src_main;
+  uint8  bg_main  = !swap ? pixel.bg_main  : pixel.bg_sub;
+  uint8  bg_sub   = !swap ? pixel.bg_sub   : pixel.bg_main;
+  uint8  ce_main  = !swap ? pixel.ce_main  : pixel.ce_sub;
+
+  if(!p.regs.addsub_mode) {
+    bg_sub  = PPU::BACK;
+    src_sub = p.regs.color_rgb;
+  }
+
+  if(!p.window[PPU::COL].main[x]) {
+    if(!p.window[PPU::COL].sub[x]) return 0x0000;
+    src_main = 0x0000;
+  }
+
+  if(!ce_main && p.regs.color_enabled[bg_main] && p.window[PPU::COL].sub[x]) {
+    bool halve = p.regs.color_halve && p.window[PPU::COL].main[x] && !(p.regs.addsub_mode && bg_sub == PPU::BACK);
+    return p.addsub(src_main, src_sub, halve);
+  }
+  return src_main;
+}
+
+//compose_operands() + compose_math() on random lines, covering color window clipping,
+//color exemption, fixed color vs subscreen operands and the hires swap
+static void test_compose() {
+  uint16 output[256];
+  unsigned checked = 0;
+
+  for(unsigned line = 0; line < 20000; line++) {
+    uint32 r = random_next();
+    ppu.regs.color_mode  = r & 1;
+    ppu.regs.color_halve = r & 2;
+    ppu.regs.addsub_mode = r & 4;
+    ppu.regs.color_rgb   = (r >> 8) & 0x7fff;
+    for(unsigned n = 0; n < 6; n++) ppu.regs.color_enabled[n] = (r >> (24 + n)) & 1;
+
+    for(unsigned x = 0; x < 256; x++) {
+      PPU::pixel_t &pixel = ppu.pixel_cache[x];
+      uint32 p = random_next();
+      pixel.src_main = p & 0x7fff;
+      pixel.src_sub  = (p >> 15) & 0x7fff;
+      p = random_next();
+      pixel.bg_main = p % 6;
+      pixel.bg_sub  = (p >> 4) % 6;
+      pixel.ce_main = (p >> 8 & 7) == 0;
+      pixel.ce_sub  = (p >> 11 & 7) == 0;
+      ppu.window[PPU::COL].main[x] = (p >> 14) & 1;
+      ppu.window[PPU::COL].sub[x]  = (p >> 15) & 1;
+    }
+
+    for(unsigned swap = 0; swap < 2; swap++) {
+      ppu.compose_operands(swap);
+      ppu.compose_math(output);
+      for(unsigned x = 0; x < 256; x++) {
+        uint16 expected = reference_pixel(x, swap);
+        if(output[x] != expected && failures++ < 10) {
+          printf("compose mismatch: line=%u x=%u swap=%u = %04x, expected %04x\n", line, x, swap, output[x], expected);
+        }
+      }
+      checked += 256;
+    }
+  }
+  printf("compose: %u pixels checked\n", checked);
+}
+
+int main() {
+  #if defined(__SSE2__)
+  printf("color math: SSE2\n");
+  #else
+  printf("color math: scalar\n");
+  #endif
+
+  test_window_tables();
+  test_color_math();
+  test_compose();
+
+  if(failures) {
+    printf("%u failures\n", failures);
+    return 1;
+  }
+  printf("passed\n");
+  return 0;
+}
@@ -0,0 +1,69 @@
+//times System::serialize() and System::unserialize() on a running system, so that changes
+//to the save state path (nall::serializer, the per-chip serialize functions) can be measured
+
+#include <snes.hpp>
+#include <nall/filemap.hpp>
+#include <nall/snes/cartridge.hpp>
+
+#include <chrono>
+
+struct Bench : SNES::Interface {
+  void message(const string &text) {}
+} bench;
+
+static double timestamp() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main(int argc, char **argv) {
+  unsigned iterations = 1000;
+  string filename;
+
+  for(int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if(arg == "-n" && i + 1 < argc) iterations = max(1u, (unsigned)decimal(argv[++i]));
+    else if(arg.beginswith("-")) { printf("usage: serialize-bench [-n iterations] [file.sfc]\n"); return 1; }
+    else filename = arg;
+  }
+
+  SNES::config.random = false;
+  SNES::system.init(&bench);
+
+  if(filename != "") {
+    filemap rom;
+    if(rom.open(filename, filemap::mode::read) == false) {
+      printf("unable to open %s\n", (const char*)filename);
+      return 1;
+    }
+    SNES::memory::cartrom.copy(rom.data(), rom.size());
+    SNES::cartridge.load(SNES::Cartridge::Mode::Normal, lstring() << SNESCartridge(rom.data(), rom.size()).xmlMemoryMap);
+  } else {
+    //without a cartridge image, time the state of the base system
+    const char *emptyCart = "<?xml version='1.0' encoding='UTF-8'?><cartridge region='NTSC' />";
+    SNES::cartridge.load(SNES::Cartridge::Mode::Normal, lstring() << emptyCart);
+  }
+  SNES::system.power();
+  for(unsigned n = 0; n < 60; n++) SNES::system.run();
+
+  serializer state = SNES::system.serialize();
+  double start = timestamp();
+  for(unsigned n = 0; n < iterations; n++) state = SNES::system.serialize();
+  double serializeTime = timestamp() - start;
+
+  start = timestamp();
+  for(unsigned n = 0; n < iterations; n++) {
+    serializer s(state.data(), state.size());
+    if(SNES::system.unserialize(s) == false) {
+      printf("unserialize failed\n");
+      return 1;
+    }
+  }
+  double unserializeTime = timestamp() - start;
+
+  printf("state size:  %u bytes\n", state.size());
+  printf("serialize:   %8.1fus\n", serializeTime * 1000000 / iterations);
+  printf("unserialize: %8.1fus\n", unserializeTime * 1000000 / iterations);
+
+  SNES::cartridge.unload();
+  return 0;
+}
@@ -0,0 +1,103 @@
+//times the SuperFX core on a generated cartridge: the S-CPU restarts the GSU in a loop, and the
+//GSU runs a cached loop that covers the ALT0-ALT3 forms of the arithmetic, logic, multiply,
+//shift, load/store and branch opcodes, so that instruction dispatch dominates the run time
+
+#include <snes.hpp>
+#include <nall/snes/cartridge.hpp>
+
+#include <chrono>
+
+struct Bench : SNES::Interface {
+  void message(const string &text) {}
+} bench;
+
+static double timestamp() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void build(uint8_t *rom, unsigned size) {
+  memset(rom, 0, size);
+  array<uint8_t> cpu, gsu;
+  auto emit = [](array<uint8_t> &code, std::initializer_list<uint8_t> bytes) {
+    for(auto byte : bytes) code.append(byte);
+  };
+
+  //S-CPU: copies a stub to WRAM $0200 that starts the GSU at $00:9000, waits for it to stop,
+  //acknowledges the IRQ and counts completed runs at $7e:0100
+  static const uint8_t stub[] = {
+    0xa2, 0x00, 0x90, 0x8e, 0x1e, 0x30,        //ldx #$9000; stx $301e (R15: start)
+    0xad, 0x30, 0x30, 0x29, 0x20, 0xd0, 0xf9,  //lda $3030; and #$20; bne (wait for GO = 0)
+    0xad, 0x31, 0x30,                          //lda $3031 (acknowledge)
+    0xc2, 0x20, 0xee, 0x00, 0x01, 0xe2, 0x20,  //rep #$20; inc $0100; sep #$20
+    0x4c, 0x00, 0x02,                          //jmp $0200
+  };
+  emit(cpu, { 0x78, 0x18, 0xfb, 0xc2, 0x10, 0xe2, 0x20 });  //sei; clc; xce; rep #$10; sep #$20
+  emit(cpu, { 0xa9, 0x18, 0x8d, 0x3a, 0x30 });              //SCMR: ROM and RAM to the GSU
+  emit(cpu, { 0xa9, 0x00, 0x8d, 0x34, 0x30, 0x8d, 0x37, 0x30 });  //PBR = 0, CFGR = 0
+  for(unsigned n = 0; n < sizeof stub; n++) {
+    emit(cpu, { 0xa9, stub[n], 0x8d, (uint8_t)(0x0200 + n), (uint8_t)((0x0200 + n) >> 8) });
+  }
+  emit(cpu, { 0x9c, 0x00, 0x01, 0x9c, 0x01, 0x01 });  //stz $0100; stz $0101
+  emit(cpu, { 0x4c, 0x00, 0x02 });                    //jmp $0200
+
+  //GSU, at ROM offset $1000 ($00:9000)
+  emit(gsu, { 0xf0, 0x34, 0x12, 0xf1, 0x01, 0x00, 0xf2, 0x00, 0x00, 0xf3, 0x07, 0x00 });  //iwt r0-r3
+  emit(gsu, { 0xf4, 0x03, 0x00, 0xf5, 0x05, 0x00, 0xf7, 0xff, 0x0f, 0xf8, 0xf0, 0x00 });  //iwt r4, r5, r7, r8
+  emit(gsu, { 0xfc, 0x00, 0x04 });  //iwt r12, #$0400 (loop count)
+  unsigned loop = 0x9000 + gsu.size() + 4;
+  emit(gsu, { 0xfd, (uint8_t)loop, (uint8_t)(loop >> 8) });  //iwt r13, #loop
+  emit(gsu, { 0x02 });  //cache
+  emit(gsu, { 0x51, 0x3d, 0x52, 0x3e, 0x53, 0x63, 0x3d, 0x63 });  //add r1; adc r2; add #3; sub r3; sbc r3
+  emit(gsu, { 0x84, 0x3d, 0x85, 0x26, 0x50 });                    //mult r4; umult r5; with r6; add r0
+  emit(gsu, { 0x03, 0x04, 0x4d, 0x4f, 0x77, 0xc8, 0x3d, 0xc7 });  //lsr; rol; swap; not; and r7; or r8; xor r7
+  emit(gsu, { 0xd9, 0xea, 0xab, 0x05 });                          //inc r9; dec r10; ibt r11, #5
+  emit(gsu, { 0x95, 0x96, 0x97, 0x9e, 0xc0, 0x70 });              //sex; asr; ror; lob; hib; merge
+  emit(gsu, { 0x9f, 0x3d, 0x9f });                                //fmult; lmult
+  emit(gsu, { 0x32, 0x42, 0x3f, 0x63, 0x08, 0x00, 0x01 });        //stw (r2); ldw (r2); cmp r3; bne; nop
+  emit(gsu, { 0x3c, 0x01 });  //loop; nop
+  emit(gsu, { 0x00, 0x01 });  //stop; nop
+
+  memcpy(rom, cpu.get(), cpu.size());
+  memcpy(rom + 0x1000, gsu.get(), gsu.size());
+  memcpy(rom + 0x7fc0, "SUPERFX BENCHMARK    ", 21);
+  rom[0x7fbd] = 0x05;  //32KB expansion RAM
+  rom[0x7fd5] = 0x20;  //LoROM
+  rom[0x7fd6] = 0x15;  //SuperFX with RAM
+  rom[0x7fd7] = 0x09;
+  rom[0x7fdc] = 0xff;
+  rom[0x7fdd] = 0xff;
+  rom[0x7ffc] = 0x00;  //reset vector: $8000
+  rom[0x7ffd] = 0x80;
+}
+
+int main(int argc, char **argv) {
+  unsigned frames = 600;
+  for(int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if(arg == "-n" && i + 1 < argc) frames = max(1u, (unsigned)decimal(argv[++i]));
+    else { printf("usage: superfx-bench [-n frames]\n"); return 1; }
+  }
+
+  enum : unsigned { RomSize = 0x80000 };
+  uint8_t *rom = new uint8_t[RomSize];
+  build(rom, RomSize);
+
+  SNES::config.random = false;
+  SNES::config.superfx.threaded = false;
+  SNES::system.init(&bench);
+  SNES::memory::cartrom.copy(rom, RomSize);
+  SNES::cartridge.load(SNES::Cartridge::Mode::Normal, lstring() << SNESCartridge(rom, RomSize).xmlMemoryMap);
+  SNES::system.power();
+  delete[] rom;
+
+  double start = timestamp();
+  for(unsigned n = 0; n < frames; n++) SNES::system.run();
+  double elapsed = timestamp() - start;
+
+  unsigned runs = SNES::memory::wram[0x100] | SNES::memory::wram[0x101] << 8;
+  printf("%u frames in %.1fms (%.1fx realtime), %u GSU runs, r6 = %04x\n",
+    frames, elapsed * 1000, frames / 60.0 / elapsed, runs, (unsigned)SNES::superfx.regs.r[6]);
+
+  SNES::cartridge.unload();
+  return 0;
+}
@@ -0,0 +1,48 @@
+//tracerender: converts binary trace logs (-trace.bin) written by the debugger into the
+//text trace log format, without loading the cartridge or the user interface
+
+#include <snes.hpp>
+#include <nall/filemap.hpp>
+
+int main(int argc, char **argv) {
+  bool hclocks = false;
+  lstring files;
+
+  for(int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if(arg == "-c") hclocks = true;
+    else if(arg.beginswith("-")) { files.reset(); break; }
+    else files.append(arg);
+  }
+
+  if(files.size() == 0 || files.size() > 2) {
+    printf("usage: tracerender [-c] input-trace.bin [output.log]\n");
+    printf("  -c  show H-position in clocks instead of dots\n");
+    printf("  the output defaults to the input name with a .log extension\n");
+    return 1;
+  }
+
+  string outputName = files.size() == 2 ? files[1] : string() << nall::basename(files[0]) << ".log";
+
+  filemap input;
+  if(input.open(files[0], filemap::mode::read) == false) {
+    printf("unable to open %s\n", (const char*)files[0]);
+    return 1;
+  }
+
+  file output;
+  if(output.open(outputName, file::mode::write) == false) {
+    printf("unable to write %s\n", (const char*)outputName);
+    return 1;
+  }
+
+  SNES::CPUcoreTrace renderer;
+  bool valid = renderer.render(output, input.data(), input.size(), hclocks);
+  output.close();
+  if(valid == false) {
+    printf("%s is not a binary trace log\n", (const char*)files[0]);
+    ::remove(outputName);
+    return 1;
+  }
+  return 0;
+}
@@ -4,6 +4,7 @@ Application application;
 
 #include "init.cpp"
 #include "arguments.cpp"
+#include "pacer.cpp"
 
 VideoDisplay::VideoDisplay() {
   outputWidth = 0;
@@ -131,6 +132,7 @@ int Application::main(int &argc, char **argv) {
   if(!QFile::exists(cheatsFilename)) {
     QFile::copy(":/cheats.xml", cheatsFilename);
   }
+  cheatDatabase.open(cheatsFilename);
 
   config().load(configFilename);
   mapper().bind();
@@ -151,6 +153,7 @@ int Application::main(int &argc, char **argv) {
   }
 
   cartridge.unload();
+  cartridgeIndex.stop();
   config().save(configFilename);
   return 0;
 }
@@ -161,9 +164,13 @@ void Application::run() {
     app->quit();
     return;
   }
-  
+
+  pacer.active = config().system.framePacing && !config().video.synchronize;
+  if(SNES::cartridge.loaded() && !pause && !autopause && (!debug || debugrun) && !pacer.ready()) return;
+
   utility.updateSystemState();
   mapper().poll();
+  state.poll();
 
   if(config().input.focusPolicy == Configuration::Input::FocusPolicyPauseEmulation) {
     bool active = mainWindow->isActive();
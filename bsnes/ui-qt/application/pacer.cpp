@@ -0,0 +1,110 @@
+FramePacer pacer;
+
+//clock_nanosleep() with an absolute deadline is only available on Linux and the BSDs;
+//other platforms use the standard steady clock
+int64_t FramePacer::time() {
+  #if defined(PLATFORM_X)
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+  #else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  #endif
+}
+
+void FramePacer::sleepUntil(int64_t target) {
+  #if defined(PLATFORM_X)
+  timespec ts;
+  ts.tv_sec = target / 1000000000;
+  ts.tv_nsec = target % 1000000000;
+  while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, 0) == EINTR);
+  #else
+  std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(target)));
+  #endif
+}
+
+//frequency is the rate at which the resampler consumes emulated audio samples
+void FramePacer::setRate(unsigned frequency) {
+  rate = frequency ? frequency : 32000;
+  reset();
+}
+
+void FramePacer::reset() {
+  deadline = 0;
+  period = 0;
+  correction = 1.0;
+  samples = 0;
+  blocked = 0;
+}
+
+//called before each frame is emulated; returns false while the next frame is not yet due, after sleeping
+//for at most IdleSlice, so that Qt can process events in between
+bool FramePacer::ready() {
+  int64_t now = time();
+  frameStart = now;
+  if(!active || deadline == 0) return true;
+
+  int64_t start = deadline + period - lead - StartMargin;
+  if(now >= start) return true;
+
+  sleepUntil(min(start, now + IdleSlice));
+  frameStart = time();
+  return frameStart >= start;
+}
+
+//called once the frame is rendered, right before it is shown; waits for its deadline
+void FramePacer::present() {
+  unsigned frameSamples = samples;
+  int64_t frameBlocked = blocked;
+  samples = 0;
+  blocked = 0;
+  if(!active) return;
+
+  int64_t now = time();
+  period = (int64_t)(1000000000.0 * frameSamples / rate * correction);
+
+  if(deadline == 0 || now > deadline + period * 3 || frameSamples == 0) {
+    //first frame, or resuming after a pause or a stall: re-anchor the schedule instead of racing to catch up
+    deadline = now;
+    lastPresent = now;
+    return;
+  }
+
+  deadline += period;
+  lead = (lead * 15 + max((int64_t)0, now - frameStart)) / 16;
+
+  if(now < deadline) {
+    if(deadline - now > SpinMargin) sleepUntil(deadline - SpinMargin);
+    while((now = time()) < deadline);
+  }
+
+  //audio driver back-pressure means frames are produced faster than the sound card plays them
+  if(frameBlocked > Millisecond / 4) correction = min(1.005, correction + 0.0002);
+  else correction = max(0.995, correction - 0.00001);
+
+  int64_t jitter = now - lastPresent - period;
+  jitterSum += jitter < 0 ? -jitter : jitter;
+  jitterMax = max(jitterMax, jitter < 0 ? -jitter : jitter);
+  jitterCount++;
+  lastPresent = now;
+
+  if(now - statsTime >= 1000000000) {
+    jitterAverage = jitterCount ? jitterSum / jitterCount : 0;
+    jitterPeak = jitterMax;
+    jitterSum = jitterMax = 0;
+    jitterCount = 0;
+    statsTime = now;
+  }
+}
+
+FramePacer::FramePacer() {
+  active = false;
+  jitterAverage = jitterPeak = 0;
+  rate = 32000;
+  lead = 0;
+  frameStart = lastPresent = 0;
+  statsTime = 0;
+  jitterSum = jitterMax = 0;
+  jitterCount = 0;
+  reset();
+}
@@ -0,0 +1,46 @@
+//schedules frame presentation against a high-resolution clock instead of relying on audio or video blocking.
+//each frame is due one audio period after the previous one (samples generated / resampler input rate),
+//so pacing follows the emulation speed setting; when audio is synchronized, time spent blocked in the
+//audio driver nudges the period to track the sound card's clock.
+struct FramePacer {
+  bool active;          //set by Application::run from config().system.framePacing
+  unsigned samples;     //audio samples generated by the frame being emulated
+  int64_t blocked;      //nanoseconds spent waiting on the audio driver this frame
+
+  //mean and peak deviation of presented frame intervals, in nanoseconds; updated once per second
+  int64_t jitterAverage;
+  int64_t jitterPeak;
+
+  static int64_t time();
+  void setRate(unsigned frequency);
+  void reset();
+  bool ready();
+  void present();
+
+  FramePacer();
+
+private:
+  enum : int64_t {
+    Millisecond = 1000000,
+    IdleSlice   = 1 * Millisecond,    //longest sleep before returning to the Qt event loop
+    SpinMargin  = Millisecond / 2,    //final stretch before a deadline is busy-waited
+    StartMargin = 2 * Millisecond,    //frames start this far ahead of their expected emulation time
+  };
+
+  void sleepUntil(int64_t target);
+
+  double rate;
+  double correction;
+  int64_t deadline;     //presentation time of the previous frame; 0 = not anchored
+  int64_t period;       //length of the previous frame
+  int64_t frameStart;
+  int64_t lastPresent;
+  int64_t lead;         //average time from frame start to presentation
+
+  int64_t statsTime;
+  int64_t jitterSum;
+  int64_t jitterMax;
+  unsigned jitterCount;
+};
+
+extern FramePacer pacer;
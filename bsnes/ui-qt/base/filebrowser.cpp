@@ -121,6 +121,7 @@ FileBrowser::FileBrowser() {
   connect(this, SIGNAL(activated(const string&)), this, SLOT(activate(const string&)));
   connect(this, SIGNAL(accepted(const string&)), this, SLOT(accept(const string&)));
   connect(previewApplyPatch, SIGNAL(stateChanged(int)), this, SLOT(toggleApplyPatch()));
+  connect(&cartridgeIndex, SIGNAL(updated(const QString&)), this, SLOT(indexUpdated(const QString&)));
   
   nativeOpen = false;
 }
@@ -159,15 +160,23 @@ void FileBrowser::onChangeCartridge(const string &path) {
   string patchBPS(filepath(nall::basename(filename), config().path.patch), ".bps");
   string patchIPS(filepath(nall::basename(filename), config().path.patch), ".ips");
 
-  if(file::exists(filename)) {
-    Cartridge::Information cartinfo;
-    if(cartridge.information(filename, cartinfo)) {
+  //header information comes from the cartridge index, so selecting a file never blocks on I/O
+  previewPath = path;
+  if(filename != "" && cartridgeIndex.indexable(filename)) {
+    cartridgeIndex.scan(nall::dir(filename));
+    CartridgeIndex::Entry entry;
+    if(cartridgeIndex.lookup(filename, entry) == false) {
+      info = "<small><font color='#808080'>Reading ...</font></small>";
+    } else if(entry.valid) {
+      Cartridge::Information &cartinfo = entry.info;
       info << "<small><table>";
       info << "<tr><td><b>Title: </b></td><td>" << cartinfo.name << "</td></tr>";
       info << "<tr><td><b>Region: </b></td><td>" << cartinfo.region << "</td></tr>";
       info << "<tr><td><b>ROM: </b></td><td>" << cartinfo.romSize * 8 / 1024 / 1024 << "mbit</td></tr>";
       info << "<tr><td><b>RAM: </b></td><td>";
       cartinfo.ramSize ? info << cartinfo.ramSize * 8 / 1024 << "kbit</td></tr>" : info << "None</td></tr>";
+      info << "<tr><td><b>CRC32: </b></td><td>" << hex<8>(entry.crc32) << "</td></tr>";
+      if(entry.images > 1) info << "<tr><td><b>Archive: </b></td><td>" << entry.images << " images</td></tr>";
       info << "</table></small>";
     }
   }
@@ -178,6 +187,13 @@ void FileBrowser::onChangeCartridge(const string &path) {
   previewApplyPatch->setVisible(file::exists(patchUPS) || file::exists(patchBPS) || file::exists(patchIPS));
 }
 
+//refreshes the preview once the index has caught up with the selected file
+void FileBrowser::indexUpdated(const QString &filename) {
+  if(previewPath == "" || !isVisible()) return;
+  string current = QDir(QString::fromUtf8(previewPath)).exists() ? resolveFilename(previewPath) : previewPath;
+  if(current == filename.toUtf8().constData()) onChangeCartridge(previewPath);
+}
+
 void FileBrowser::onAcceptCartridge(const string &path) {
   string filename;
   if(QDir(path).exists()) {
@@ -20,6 +20,7 @@ private slots:
   void activate(const string&);
   void accept(const string&);
   void toggleApplyPatch();
+  void indexUpdated(const QString&);
 
 private:
   QVBoxLayout *previewLayout;
@@ -29,6 +30,7 @@ private:
   QCheckBox *previewApplyPatch;
 
   bool nativeOpen;
+  string previewPath;
 
   string resolveFilename(const string&);
   void onChangeCartridge(const string&);
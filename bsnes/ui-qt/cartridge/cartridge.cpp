@@ -2,6 +2,8 @@
 #include <nall/bps/patch.hpp>
 Cartridge cartridge;
 
+#include "index.cpp"
+
 //================
 //public functions
 //================
@@ -10,55 +12,60 @@ bool Cartridge::information(const char *filename, Cartridge::Information &info)
   file fp;
   if(fp.open(filename, file::mode::read) == false) return false;
 
-  if(striend(filename, ".sfc")) {
-    if(fp.size() < 0x8000) return false;
+  unsigned size = fp.size();
+  uint8_t *data = new uint8_t[size];
+  fp.read(data, size);
+  fp.close();
 
-    unsigned offset = 0;
-    if((fp.size() & 0x7fff) == 512) offset = 512;
+  bool result = information(filename, data, size, info);
+  delete[] data;
+  return result;
+}
 
-    uint16_t complement, checksum;
+//filename only selects the image type, by extension
+bool Cartridge::information(const char *filename, const uint8_t *data, unsigned size, Cartridge::Information &info) {
+  auto read = [&](unsigned addr) -> uint8_t { return addr < size ? data[addr] : 0xff; };
 
-    fp.seek(0x7fdc + offset);
-    complement = fp.readl(2);
-    checksum = fp.readl(2);
+  if(striend(filename, ".sfc") || striend(filename, ".smc") || striend(filename, ".swc") || striend(filename, ".fig")) {
+    if(size < 0x8000) return false;
+
+    unsigned offset = 0;
+    if((size & 0x7fff) == 512) offset = 512;
+
+    uint16_t complement = read(0x7fdc + offset) | (read(0x7fdd + offset) << 8);
+    uint16_t checksum   = read(0x7fde + offset) | (read(0x7fdf + offset) << 8);
 
     unsigned header = offset + (complement + checksum == 65535 ? 0x7fb0 : 0xffb0);
 
-    fp.seek(header + 0x10);
     char name[22];
-    fp.read((uint8_t*)name, 21);
+    for(unsigned i = 0; i < 21; i++) name[i] = read(header + 0x10 + i);
     name[21] = 0;
     info.name = decodeJISX0201(name);
 
-    fp.seek(header + 0x29);
-    uint8_t region = fp.read();
+    uint8_t region = read(header + 0x29);
     info.region = (region <= 1 || region >= 13) ? "NTSC" : "PAL";
 
-    info.romSize = fp.size() & ~0x7fff;
+    info.romSize = size & ~0x7fff;
 
-    fp.seek(header + 0x28);
-    uint8_t ramsize = fp.read();
+    uint8_t ramsize = read(header + 0x28);
     info.ramSize = (ramsize == 0) ? 0 : (1024 << (ramsize & 7));
 
     return true;
   } else if(striend(filename, ".gb") || striend(filename, ".gbc")) {
-    if(fp.size() < 0x200) return false;
+    if(size < 0x200) return false;
 
-    fp.seek(0x134);
     char name[17];
-    fp.read((uint8_t*)name, 16);
+    for(unsigned i = 0; i < 16; i++) name[i] = read(0x134 + i);
     name[16] = 0;
     if(name[15] & 0x80) name[15] = 0;  //strip GBC flag
     info.name = decodeJISX0201(name);
 
-    fp.seek(0x147);
-    uint8_t mbctype   =   fp.read();
-    /*uint8_t romsize =*/ fp.read();
-    uint8_t ramsize   =   fp.read();
-    uint8_t region    =   fp.read();
+    uint8_t mbctype   =   read(0x147);
+    uint8_t ramsize   =   read(0x149);
+    uint8_t region    =   read(0x14a);
 
     info.region = (region == 0) ? "Japan" : "World";
-    info.romSize = fp.size();
+    info.romSize = size;
 
     if(mbctype == 0x06) info.ramSize = 256;
     else switch(ramsize) {
@@ -73,18 +80,16 @@ bool Cartridge::information(const char *filename, Cartridge::Information &info)
 
     return true;
   } else if(striend(filename, ".st")) {
-    if(fp.size() < 0x40) return false;
+    if(size < 0x40) return false;
 
-    fp.seek(0x10);
     char name[15];
-    fp.read((uint8_t*)name, 14);
+    for(unsigned i = 0; i < 14; i++) name[i] = read(0x10 + i);
     name[14] = 0;
     info.name = decodeJISX0201(name);
     info.region = "NTSC";
-    info.romSize = fp.size();
+    info.romSize = size;
 
-    fp.seek(0x37);
-    info.ramSize = fp.read() * 2048;
+    info.ramSize = read(0x37) * 2048;
 
     return true;
   }
@@ -509,8 +514,13 @@ bool Cartridge::loadCartridge(string &filename, string &xml, SNES::MappedRAM &me
     xml = SNESCartridge(data, size).xmlMemoryMap;
   }
 
-  memory.copy(data, size);
-  delete[] data;
+  if(memory.data() == 0 && size > 0 && (size & 255) == 0) {
+    //the reader's buffer is already page-aligned in size; hand it over rather than copying it
+    memory.map(data, size);
+  } else {
+    memory.copy(data, size);
+    delete[] data;
+  }
   return true;
 }
 
@@ -19,6 +19,7 @@ public:
   };
 
   bool information(const char*, Information&);
+  bool information(const char*, const uint8_t*, unsigned, Information&);
   bool saveStatesSupported();
 
   bool loadNormal(const char*);
@@ -0,0 +1,302 @@
+#include "index.moc"
+CartridgeIndex cartridgeIndex;
+
+bool CartridgeIndex::indexable(const string &filename) {
+  start();
+  return imageType(filename) || archiveType(filename);
+}
+
+//returns the cached entry for filename; on a miss, the file is queued ahead of everything else,
+//and updated(filename) is emitted once it has been indexed
+bool CartridgeIndex::lookup(const string &filename, Entry &entry) {
+  start();
+  std::lock_guard<std::mutex> guard(lock);
+  auto item = table.find(QString::fromUtf8(filename));
+  if(item != table.end()) {
+    entry = item.value();
+    return true;
+  }
+  priority = filename;
+  wake.notify_one();
+  return false;
+}
+
+//queues a directory for indexing; entries already cached are revalidated against mtime and size
+void CartridgeIndex::scan(const string &path) {
+  start();
+  std::lock_guard<std::mutex> guard(lock);
+  if(scanned.find(path) || queue.find(path)) return;
+  queue.append(path);
+  wake.notify_one();
+}
+
+void CartridgeIndex::stop() {
+  if(!thread.joinable()) return;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    quit = true;
+    wake.notify_one();
+  }
+  thread.join();
+}
+
+void CartridgeIndex::start() {
+  if(thread.joinable()) return;
+
+  filename = "cartridge-index.bin";
+  application.locateFile(filename, true);
+
+  archiveList.split(" ", reader.compressionList);
+  for(unsigned i = 0; i < archiveList.size(); i++) archiveList[i].ltrim("*");
+
+  thread = std::thread(&CartridgeIndex::worker, this);
+}
+
+void CartridgeIndex::worker() {
+  load();
+
+  std::unique_lock<std::mutex> guard(lock);
+  while(!quit) {
+    if(priority != "") {
+      string name = priority;
+      priority = "";
+      guard.unlock();
+      refresh(name);
+      guard.lock();
+      continue;
+    }
+
+    if(queue.size() > 0) {
+      string path = queue[0];
+      queue.remove(0);
+      scanned.append(path);
+      guard.unlock();
+      scanDirectory(path);
+      guard.lock();
+      continue;
+    }
+
+    if(dirty) {
+      guard.unlock();
+      save();
+      guard.lock();
+      continue;
+    }
+
+    wake.wait(guard);
+  }
+
+  guard.unlock();
+  if(dirty) save();
+}
+
+void CartridgeIndex::scanDirectory(const string &path) {
+  QFileInfoList list = QDir(QString::fromUtf8(path)).entryInfoList(QDir::Files, QDir::Name);
+  for(int i = 0; i < list.size(); i++) {
+    string name = list[i].absoluteFilePath().toUtf8().constData();
+    if(!imageType(name) && !archiveType(name)) continue;
+
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      if(quit) return;
+      if(priority != "") {
+        //the browser is waiting on a file; serve it before continuing the scan
+        string request = priority;
+        priority = "";
+        guard.unlock();
+        refresh(request);
+      }
+    }
+
+    refresh(name);
+  }
+}
+
+//indexes filename unless the cached entry still matches its modification time and size.
+//paths that are not regular files get an empty entry, so that a browser waiting on them is answered
+void CartridgeIndex::refresh(const string &filename) {
+  QFileInfo fileInfo(QString::fromUtf8(filename));
+
+  Entry entry;
+  entry.mtime = 0;
+  entry.size = 0;
+  if(fileInfo.isFile()) {
+#if QT_VERSION >= 0x050800
+    entry.mtime = fileInfo.lastModified().toSecsSinceEpoch();
+#else
+    entry.mtime = fileInfo.lastModified().toTime_t();
+#endif
+    entry.size = fileInfo.size();
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    auto item = table.find(QString::fromUtf8(filename));
+    if(item != table.end() && item.value().mtime == entry.mtime && item.value().size == entry.size) return;
+  }
+
+  index(filename, entry);
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    table.insert(QString::fromUtf8(filename), entry);
+    dirty = true;
+  }
+  emit updated(QString::fromUtf8(filename));
+}
+
+void CartridgeIndex::index(const string &filename, Entry &entry) {
+  entry.images = 0;
+  entry.image = "";
+  entry.valid = false;
+  entry.info.romSize = entry.info.ramSize = 0;
+  entry.crc32 = 0;
+  memset(entry.sha256, 0, sizeof entry.sha256);
+  if(entry.size == 0) return;  //missing, not a regular file, or empty
+
+  uint8_t *data = 0;
+  unsigned size = 0;
+  string image = filename;
+
+  if(archiveType(filename)) {
+    //archives are described by their first image
+    lstring names;
+    if(!reader.list || !reader.extract || !reader.list(filename, names)) return;
+    entry.images = names.size();
+    entry.image = names[0];
+    if(names[0] != "") image = names[0];
+    else image = nall::basename(filename);  //single-image formats: foo.sfc.gz -> foo.sfc
+    if(!reader.extract(filename, names[0], data, size)) return;
+  } else {
+    file fp;
+    if(fp.open(filename, file::mode::read) == false) return;
+    entry.images = 1;
+    data = new uint8_t[size = fp.size()];
+    fp.read(data, size);
+    fp.close();
+  }
+
+  entry.valid = cartridge.information(image, data, size, entry.info);
+
+  unsigned offset = (size & 0x7fff) == 512 ? 512 : 0;
+  entry.crc32 = crc32_calculate(data + offset, size - offset);
+  sha256_ctx sha;
+  sha256_init(&sha);
+  sha256_chunk(&sha, data + offset, size - offset);
+  sha256_final(&sha);
+  sha256_hash(&sha, entry.sha256);
+
+  delete[] data;
+}
+
+bool CartridgeIndex::imageType(const string &filename) const {
+  return striend(filename, ".sfc") || striend(filename, ".smc")
+  || striend(filename, ".swc") || striend(filename, ".fig")
+  || striend(filename, ".bs")  || striend(filename, ".st")
+  || striend(filename, ".gb")  || striend(filename, ".sgb") || striend(filename, ".gbc");
+}
+
+bool CartridgeIndex::archiveType(const string &filename) const {
+  for(unsigned i = 0; i < archiveList.size(); i++) {
+    if(archiveList[i] != "" && striend(filename, archiveList[i])) return true;
+  }
+  return false;
+}
+
+//on-disk format: signature, version, entry count, then each entry's fields in declaration order;
+//integers are little-endian, strings are a 32-bit length followed by UTF-8 bytes
+void CartridgeIndex::load() {
+  file fp;
+  if(fp.open(filename, file::mode::read) == false) return;
+  unsigned size = fp.size();
+  uint8_t *data = new uint8_t[size];
+  fp.read(data, size);
+  fp.close();
+
+  const uint8_t *p = data, *end = data + size;
+  bool valid = true;
+  auto read = [&](unsigned length) -> uint64_t {
+    if((unsigned)(end - p) < length) { valid = false; return 0; }
+    uint64_t value = 0;
+    for(unsigned n = 0; n < length; n++) value |= (uint64_t)*p++ << (n << 3);
+    return value;
+  };
+  auto text = [&]() -> string {
+    unsigned length = read(4);
+    if(!valid || (unsigned)(end - p) < length) { valid = false; return ""; }
+    char *buffer = new char[length + 1];
+    memcpy(buffer, p, length);
+    buffer[length] = 0;
+    p += length;
+    string result = buffer;
+    delete[] buffer;
+    return result;
+  };
+
+  if(read(4) == Signature && read(4) == Version) {
+    unsigned count = read(4);
+    std::lock_guard<std::mutex> guard(lock);
+    while(valid && count--) {
+      string name = text();
+      Entry entry;
+      entry.mtime = read(8);
+      entry.size = read(8);
+      entry.images = read(4);
+      entry.image = text();
+      entry.valid = read(1);
+      entry.info.name = text();
+      entry.info.region = text();
+      entry.info.romSize = read(4);
+      entry.info.ramSize = read(4);
+      entry.crc32 = read(4);
+      for(unsigned n = 0; n < 32; n++) entry.sha256[n] = read(1);
+      if(valid) table.insert(QString::fromUtf8(name), entry);
+    }
+  }
+
+  delete[] data;
+}
+
+void CartridgeIndex::save() {
+  QByteArray buffer;
+  auto write = [&](uint64_t value, unsigned length) {
+    while(length--) { buffer.append((char)value); value >>= 8; }
+  };
+  auto text = [&](const string &value) {
+    write(value.length(), 4);
+    buffer.append((const char*)value, value.length());
+  };
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    dirty = false;
+    write(Signature, 4);
+    write(Version, 4);
+    write(table.size(), 4);
+    for(auto item = table.begin(); item != table.end(); ++item) {
+      const Entry &entry = item.value();
+      text(item.key().toUtf8().constData());
+      write(entry.mtime, 8);
+      write(entry.size, 8);
+      write(entry.images, 4);
+      text(entry.image);
+      write(entry.valid, 1);
+      text(entry.info.name);
+      text(entry.info.region);
+      write(entry.info.romSize, 4);
+      write(entry.info.ramSize, 4);
+      write(entry.crc32, 4);
+      for(unsigned n = 0; n < 32; n++) write(entry.sha256[n], 1);
+    }
+  }
+
+  file fp;
+  if(fp.open(filename, file::mode::write) == false) return;
+  fp.write((const uint8_t*)buffer.constData(), buffer.size());
+  fp.close();
+}
+
+CartridgeIndex::CartridgeIndex() {
+  quit = false;
+  dirty = false;
+}
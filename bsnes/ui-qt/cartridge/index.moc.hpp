@@ -0,0 +1,59 @@
+//background index of cartridge images for the file browser.
+//a worker thread reads headers and checksums of images in the directories being browsed,
+//including archive members through snesreader, and caches them on disk keyed by path,
+//modification time and size; lookups from the GUI thread never touch the file system.
+class CartridgeIndex : public QObject {
+  Q_OBJECT
+
+public:
+  struct Entry {
+    uint64_t mtime;
+    uint64_t size;
+    unsigned images;  //ROM images inside an archive; 1 for plain files
+    string image;     //archive member described by info
+    bool valid;       //info holds a parsed header
+    Cartridge::Information info;
+    uint32_t crc32;   //of the image, without copier header
+    uint8_t sha256[32];
+  };
+
+  bool indexable(const string &filename);
+  bool lookup(const string &filename, Entry &entry);
+  void scan(const string &path);
+  void stop();
+
+  CartridgeIndex();
+
+signals:
+  void updated(const QString &filename);
+
+private:
+  enum : unsigned { Signature = 0x58495342, Version = 1 };  //'BSIX'
+
+  void start();
+  void worker();
+  void scanDirectory(const string &path);
+  void refresh(const string &filename);
+  void index(const string &filename, Entry &entry);
+  bool imageType(const string &filename) const;
+  bool archiveType(const string &filename) const;
+  void load();
+  void save();
+
+  string filename;
+  lstring archiveList;
+
+  std::thread thread;
+  std::mutex lock;
+  std::condition_variable wake;
+
+  //guarded by lock
+  bool quit;
+  bool dirty;
+  QHash<QString, Entry> table;
+  lstring queue;    //directories waiting to be scanned
+  lstring scanned;  //directories scanned this session
+  string priority;  //file the browser is waiting on, indexed ahead of the queue
+};
+
+extern CartridgeIndex cartridgeIndex;
@@ -29,6 +29,8 @@ Configuration::Configuration() {
   attach(SNES::config.ppu1.version = 1, "ppu1.version", "Valid version(s) are: 1");
   attach(SNES::config.ppu2.version = 3, "ppu2.version", "Valid version(s) are: 1, 2, 3");
 
+  attach(SNES::config.superfx.threaded = false, "superfx.threaded", "Run the SuperFX on a separate host thread while it owns the game pak bus; faster, less exact timing");
+
   attach(SNES::config.sat.path = "./bsxdat/", "bsx.satdata");
   attach(SNES::config.sat.local_time = true, "bsx.localTime");
   attach((signed&)(SNES::config.sat.custom_time = 798653040) /* 1995-04-23 16:04 */, "bsx.customTime");
@@ -49,6 +51,7 @@ Configuration::Configuration() {
   attach(system.speedFastest = 200, "system.speedFastest");
   attach(system.autoSaveMemory = false, "system.autoSaveMemory", "Automatically save cartridge back-up RAM once every minute");
   attach(system.rewindEnabled  = false, "system.rewindEnabled", "Automatically save states periodically to allow auto-rewind support");
+  attach(system.framePacing    = false, "system.framePacing", "Present frames on a high-resolution timer locked to the audio rate; ignored while video is synchronized");
 
   attach(diskBrowser.useCommonDialogs = false, "diskBrowser.useCommonDialogs");
   attach(diskBrowser.showPanel = true, "diskBrowser.showPanel");
@@ -121,10 +124,12 @@ Configuration::Configuration() {
   attach(input.focusPolicy = Input::FocusPolicyIgnoreInput, "input.focusPolicy");
   attach(input.allowInvalidInput = false, "input.allowInvalidInput", "Allow up+down / left+right combinations; may trigger bugs in some games");
   attach(input.modifierEnable = true, "input.modifierEnable");
+  attach(input.pollOnLatch = false, "input.pollOnLatch", "Poll controllers when the game latches them, rather than once before each frame");
 
   attach(debugger.cacheUsageToDisk = false, "debugger.cacheUsageToDisk");
   attach(debugger.saveBreakpoints = false, "debugger.saveBreakpoints");
   attach(debugger.showHClocks = false, "debugger.showHClocks");
+  attach(debugger.binaryTrace = false, "debugger.binaryTrace");
 
   attach(geometry.mainWindow        = "", "geometry.mainWindow");
   attach(geometry.loaderWindow      = "", "geometry.loaderWindow");
@@ -12,6 +12,7 @@ public:
     unsigned speedFastest;
     bool autoSaveMemory;
     bool rewindEnabled;
+    bool framePacing;
   } system;
 
   struct File {
@@ -74,12 +75,14 @@ public:
     unsigned focusPolicy;
     bool allowInvalidInput;
     bool modifierEnable;
+    bool pollOnLatch;
   } input;
 
   struct Debugger {
     bool cacheUsageToDisk;
     bool saveBreakpoints;
     bool showHClocks;
+    bool binaryTrace;
   } debugger;
 
   struct Geometry {
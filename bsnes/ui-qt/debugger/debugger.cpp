@@ -56,6 +56,7 @@ Debugger::Debugger() {
 
   menu_misc = menu->addMenu("Misc");
   menu_misc_clear = menu_misc->addAction("Clear Console");
+  menu_misc_renderTrace = menu_misc->addAction("Render Binary Trace");
   menu_misc_options = menu_misc->addAction("Options ...");
 
   consoleLayout = new QVBoxLayout;
@@ -176,6 +177,7 @@ Debugger::Debugger() {
   connect(menu_ppu_cgramViewer, SIGNAL(triggered()), cgramViewer, SLOT(show()));
 
   connect(menu_misc_clear, SIGNAL(triggered()), this, SLOT(clear()));
+  connect(menu_misc_renderTrace, SIGNAL(triggered()), tracer, SLOT(renderTrace()));
   connect(menu_misc_options, SIGNAL(triggered()), debuggerOptions, SLOT(show()));
 
   connect(runBreak->defaultAction(), SIGNAL(triggered()), this, SLOT(toggleRunStatus()));
@@ -203,6 +205,9 @@ Debugger::Debugger() {
   updateTimer->start(15);
 }
 
+// usage files start with this signature, followed by each bus's sparse SNES::UsageMap
+static const char usageSignature[8] = { 'B', 'S', 'N', 'E', 'S', 'U', 'M', '1' };
+
 void Debugger::modifySystemState(unsigned state) {
   string usagefile = filepath(nall::basename(cartridge.fileName), config().path.data);
   string bpfile = usagefile;
@@ -211,27 +216,46 @@ void Debugger::modifySystemState(unsigned state) {
   file fp;
 
   if(state == Utility::LoadCartridge) {
-    memset(SNES::cpu.cart_usage, 0x00, 1 << 24);
+    SNES::cpu.cart_usage.reset();
     
-    memset(SNES::cpu.usage, 0x00, 1 << 24);
-    memset(SNES::smp.usage, 0x00, 1 << 16);
+    SNES::cpu.usage.reset();
+    SNES::smp.usage.reset();
     
-    memset(SNES::sa1.usage, 0x00, 1 << 24);
-    memset(SNES::superfx.usage, 0x00, 1 << 23);
+    SNES::sa1.usage.reset();
+    SNES::superfx.usage.reset();
     
     if(config().debugger.cacheUsageToDisk && fp.open(usagefile, file::mode::read)) {
-      fp.read(SNES::cpu.usage, 1 << 24);
-      fp.read(SNES::smp.usage, 1 << 16);
-      if (SNES::cartridge.has_sa1())     fp.read(SNES::sa1.usage, 1 << 24);
-      if (SNES::cartridge.has_superfx()) fp.read(SNES::superfx.usage, 1 << 23);
+      char signature[sizeof usageSignature] = { 0 };
+      fp.read((uint8_t*)signature, sizeof signature);
+      if (!memcmp(signature, usageSignature, sizeof signature)) {
+        SNES::cpu.usage.load(fp);
+        SNES::smp.usage.load(fp);
+        if (SNES::cartridge.has_sa1())     SNES::sa1.usage.load(fp);
+        if (SNES::cartridge.has_superfx()) SNES::superfx.usage.load(fp);
+      } else {
+        // older versions saved every table in full
+        fp.seek(0);
+        SNES::cpu.usage.load_raw(fp, 1 << 24);
+        SNES::smp.usage.load_raw(fp, 1 << 16);
+        if (SNES::cartridge.has_sa1())     SNES::sa1.usage.load_raw(fp, 1 << 24);
+        if (SNES::cartridge.has_superfx()) SNES::superfx.usage.load_raw(fp, 1 << 23);
+      }
       fp.close();
       
       for (unsigned i = 0; i < 1 << 24; i++) {
+        bool sfx = i < 0x600000;
+        if (!SNES::cpu.usage.allocated(i) && !SNES::sa1.usage.allocated(i)
+            && !(sfx && SNES::superfx.usage.allocated(i))) {
+          // nothing was recorded in this page on any bus
+          i |= SNES::UsageMap::PageSize - 1;
+          continue;
+        }
+        
+        uint8_t flags = SNES::cpu.usage.read(i) | SNES::sa1.usage.read(i);
+        if (sfx) flags |= SNES::superfx.usage.read(i);
         int offset = SNES::cartridge.rom_offset(i);
-        if (offset >= 0) 
-          SNES::cpu.cart_usage[offset] |= SNES::cpu.usage[i] | SNES::sa1.usage[i];
-        if (offset >= 0 && i < 0x600000)
-          SNES::cpu.cart_usage[offset] |= SNES::superfx.usage[i];
+        if (offset >= 0 && flags)
+          SNES::cpu.cart_usage[offset] |= flags;
       }
     }
     
@@ -254,10 +278,11 @@ void Debugger::modifySystemState(unsigned state) {
 
   if(state == Utility::UnloadCartridge) {
     if(config().debugger.cacheUsageToDisk && fp.open(usagefile, file::mode::write)) {
-      fp.write(SNES::cpu.usage, 1 << 24);
-      fp.write(SNES::smp.usage, 1 << 16);
-      if (SNES::cartridge.has_sa1())     fp.write(SNES::sa1.usage, 1 << 24);
-      if (SNES::cartridge.has_superfx()) fp.write(SNES::superfx.usage, 1 << 23);
+      fp.write((const uint8_t*)usageSignature, sizeof usageSignature);
+      SNES::cpu.usage.save(fp);
+      SNES::smp.usage.save(fp);
+      if (SNES::cartridge.has_sa1())     SNES::sa1.usage.save(fp);
+      if (SNES::cartridge.has_superfx()) SNES::superfx.usage.save(fp);
       fp.close();
     }
     
@@ -293,6 +318,7 @@ void Debugger::synchronize() {
   SNES::debugger.step_smp = application.debug && stepSMP->isChecked();
   SNES::debugger.step_sa1 = application.debug && stepSA1->isChecked();
   SNES::debugger.step_sfx = application.debug && stepSFX->isChecked();
+  updateAttached();
 
   if(!active) {
     registerEditCPU->setEnabled(false);
@@ -369,20 +395,23 @@ void Debugger::event() {
   switch(SNES::debugger.break_event) {
     case SNES::Debugger::BreakEvent::BreakpointHit: {
       unsigned n = SNES::debugger.breakpoint_hit;
+      SNES::Debugger::Breakpoint::Source source;
       
-      if (n < SNES::Debugger::Breakpoints)
+      if (n < SNES::debugger.breakpoint.size()) {
         echo(string() << "Breakpoint " << n << " hit (" << SNES::debugger.breakpoint[n].counter << ").<br>");
-      else if (n == SNES::Debugger::SoftBreakCPU)
+        source = SNES::debugger.breakpoint[n].source;
+      } else if (n == SNES::Debugger::SoftBreakCPU) {
         echo(string() << "Software breakpoint hit (CPU).<br>");
-      else if (n == SNES::Debugger::SoftBreakSA1)
+        source = SNES::Debugger::Breakpoint::Source::CPUBus;
+      } else if (n == SNES::Debugger::SoftBreakSA1) {
         echo(string() << "Software breakpoint hit (SA-1).<br>");
-      else break;
+        source = SNES::Debugger::Breakpoint::Source::SA1Bus;
+      } else break;
         
-      if(n == SNES::Debugger::SoftBreakCPU
-           || SNES::debugger.breakpoint[n].source == SNES::Debugger::Breakpoint::Source::CPUBus
-           || SNES::debugger.breakpoint[n].source == SNES::Debugger::Breakpoint::Source::VRAM
-           || SNES::debugger.breakpoint[n].source == SNES::Debugger::Breakpoint::Source::OAM
-           || SNES::debugger.breakpoint[n].source == SNES::Debugger::Breakpoint::Source::CGRAM) {
+      if(source == SNES::Debugger::Breakpoint::Source::CPUBus
+           || source == SNES::Debugger::Breakpoint::Source::VRAM
+           || source == SNES::Debugger::Breakpoint::Source::OAM
+           || source == SNES::Debugger::Breakpoint::Source::CGRAM) {
         SNES::debugger.step_cpu = true;
         SNES::cpu.disassemble_opcode(t, SNES::cpu.opcode_pc, config().debugger.showHClocks);
         string s = t;
@@ -393,8 +422,7 @@ void Debugger::event() {
         break;
       }
 
-      if(n == SNES::Debugger::SoftBreakSA1
-           || SNES::debugger.breakpoint[n].source == SNES::Debugger::Breakpoint::Source::SA1Bus) {
+      if(source == SNES::Debugger::Breakpoint::Source::SA1Bus) {
         SNES::debugger.step_sa1 = true;
         SNES::sa1.disassemble_opcode(t, SNES::sa1.opcode_pc, config().debugger.showHClocks);
         string s = t;
@@ -405,7 +433,7 @@ void Debugger::event() {
         break;
       }
       
-      if(SNES::debugger.breakpoint[n].source == SNES::Debugger::Breakpoint::Source::APURAM) {
+      if(source == SNES::Debugger::Breakpoint::Source::APURAM) {
         SNES::debugger.step_smp = true;
         SNES::smp.disassemble_opcode(t, SNES::smp.opcode_pc);
         string s = t;
@@ -416,7 +444,7 @@ void Debugger::event() {
         break;
       }
       
-      if(SNES::debugger.breakpoint[n].source == SNES::Debugger::Breakpoint::Source::SFXBus) {
+      if(source == SNES::Debugger::Breakpoint::Source::SFXBus) {
         SNES::debugger.step_sfx = true;
         SNES::superfx.disassemble_opcode(t, SNES::superfx.opcode_pc);
         string s = t;
@@ -477,6 +505,8 @@ void Debugger::event() {
 
 // update "auto refresh" tool windows
 void Debugger::frameTick() {
+  updateAttached();
+
   unsigned frame = SNES::cpu.framecounter();
   if (frameCounter == frame) return;
 
@@ -491,6 +521,18 @@ void Debugger::frameTick() {
   frameCounter = frame;
 }
 
+// the S-CPU, SMP, SA-1 and SuperFX only run their debugger hooks (usage tracking,
+// breakpoints, stepping and tracing) while something here is able to observe them
+void Debugger::updateAttached() {
+  bool attached = isVisible() || disassembler->isVisible() || breakpointEditor->isVisible()
+               || memoryEditor->isVisible() || propertiesViewer->isVisible()
+               || tracer->enabled() || SNES::debugger.break_on_wdm;
+  for(unsigned n = 0; n < SNES::debugger.breakpoint.size(); n++) {
+    attached |= SNES::debugger.breakpoint[n].enabled;
+  }
+  SNES::debugger.attached = attached;
+}
+
 void Debugger::autoUpdate() {
   memoryEditor->autoUpdate();
   propertiesViewer->autoUpdate();
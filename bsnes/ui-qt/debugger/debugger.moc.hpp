@@ -15,6 +15,7 @@ public:
   QAction *menu_ppu_cgramViewer;
   QMenu *menu_misc;
   QAction *menu_misc_clear;
+  QAction *menu_misc_renderTrace;
   QAction *menu_misc_options;
 
   QHBoxLayout *layout;
@@ -41,6 +42,7 @@ public:
   void echo(const char *message);
   void event();
   void autoUpdate();
+  void updateAttached();
   Debugger();
 
 public slots:
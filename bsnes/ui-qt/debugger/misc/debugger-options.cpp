@@ -19,16 +19,21 @@ DebuggerOptions::DebuggerOptions() {
   layout->addWidget(saveBreakpointsBox);
   showHClocksBox = new QCheckBox("Show H-position in clocks instead of dots");
   layout->addWidget(showHClocksBox);
+  binaryTraceBox = new QCheckBox("Write trace logs in compact binary format");
+  binaryTraceBox->setToolTip("Much faster than text logging; use Misc > Render Binary Trace to convert to text");
+  layout->addWidget(binaryTraceBox);
 
   synchronize();
   connect(cacheUsageBox, SIGNAL(toggled(bool)), this, SLOT(toggleCacheUsage(bool)));
   connect(saveBreakpointsBox, SIGNAL(toggled(bool)), this, SLOT(toggleSaveBreakpoints(bool)));
   connect(showHClocksBox, SIGNAL(toggled(bool)), this, SLOT(toggleHClocks(bool)));
+  connect(binaryTraceBox, SIGNAL(toggled(bool)), this, SLOT(toggleBinaryTrace(bool)));
 }
 
 void DebuggerOptions::synchronize() {
   cacheUsageBox->setChecked(config().debugger.cacheUsageToDisk);
   showHClocksBox->setChecked(config().debugger.showHClocks);
+  binaryTraceBox->setChecked(config().debugger.binaryTrace);
 }
 
 void DebuggerOptions::toggleCacheUsage(bool on) {
@@ -42,3 +47,8 @@ void DebuggerOptions::toggleSaveBreakpoints(bool on) {
 void DebuggerOptions::toggleHClocks(bool on) {
   config().debugger.showHClocks = on;
 }
+
+void DebuggerOptions::toggleBinaryTrace(bool on) {
+  config().debugger.binaryTrace = on;
+  tracer->resetTraceState();
+}
@@ -6,6 +6,7 @@ public:
   QCheckBox *cacheUsageBox;
   QCheckBox *saveBreakpointsBox;
   QCheckBox *showHClocksBox;
+  QCheckBox *binaryTraceBox;
 
   void synchronize();
   DebuggerOptions();
@@ -14,6 +15,7 @@ public slots:
   void toggleCacheUsage(bool);
   void toggleSaveBreakpoints(bool);
   void toggleHClocks(bool);
+  void toggleBinaryTrace(bool);
 };
 
 extern DebuggerOptions *debuggerOptions;
@@ -70,6 +70,7 @@ BreakpointItem::BreakpointItem(unsigned id_) : id(id_) {
 void BreakpointItem::init() {
   SNES::debugger.breakpoint[id].enabled = false;
   SNES::debugger.breakpoint[id].counter = 0;
+  SNES::debugger.breakpoint_update();
 }
 
 void BreakpointItem::toggle() {
@@ -90,6 +91,7 @@ void BreakpointItem::toggle() {
     
     SNES::debugger.breakpoint[id].source = (SNES::Debugger::Breakpoint::Source)source->currentIndex();
   }
+  SNES::debugger.breakpoint_update();
 }
 
 void BreakpointItem::clear() {
@@ -174,15 +176,28 @@ BreakpointEditor::BreakpointEditor() {
   application.windowList.append(this);
 
   layout = new QVBoxLayout;
-  layout->setSizeConstraint(QLayout::SetFixedSize);
   layout->setMargin(Style::WindowMargin);
   layout->setSpacing(Style::WidgetSpacing);
   setLayout(layout);
 
-  for(unsigned n = 0; n < SNES::Debugger::Breakpoints; n++) {
-    breakpoint[n] = new BreakpointItem(n);
-    layout->addWidget(breakpoint[n]);
-  }
+  listLayout = new QVBoxLayout;
+  listLayout->setMargin(0);
+  listLayout->setSpacing(Style::WidgetSpacing);
+  listLayout->addStretch();
+  list = new QWidget;
+  list->setLayout(listLayout);
+
+  // there is no limit on the number of breakpoints; a new row is added whenever the last one is used
+  for(unsigned n = 0; n < 8; n++) addItem();
+
+  scrollArea = new QScrollArea;
+  scrollArea->setWidget(list);
+  scrollArea->setFrameStyle(0);
+  scrollArea->setWidgetResizable(true);
+  scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+  scrollArea->setMinimumSize(list->sizeHint().width() + scrollArea->verticalScrollBar()->sizeHint().width(),
+                             list->sizeHint().height());
+  layout->addWidget(scrollArea);
   
   breakOnWDM = new QCheckBox("Break on WDM (CPU/SA-1 opcode 0x42)");
   connect(breakOnWDM, SIGNAL(toggled(bool)), this, SLOT(toggle()));
@@ -194,13 +209,24 @@ void BreakpointEditor::toggle() {
 }
 
 void BreakpointEditor::clear() {
-  for(unsigned n = 0; n < SNES::Debugger::Breakpoints; n++) {
+  for(unsigned n = 0; n < breakpoint.size(); n++) {
     breakpoint[n]->clear();
   }
 }
 
+void BreakpointEditor::expand() {
+  if(!breakpoint[breakpoint.size() - 1]->addr->text().isEmpty()) addItem();
+}
+
+void BreakpointEditor::addItem() {
+  BreakpointItem *item = new BreakpointItem(breakpoint.size());
+  listLayout->insertWidget(breakpoint.size(), item);
+  breakpoint.append(item);
+  connect(item->addr, SIGNAL(textChanged(const QString&)), this, SLOT(expand()));
+}
+
 void BreakpointEditor::addBreakpoint(const string& addr, const string& mode, const string& source) {
-  for(unsigned n = 0; n < SNES::Debugger::Breakpoints; n++) {
+  for(unsigned n = 0; n < breakpoint.size(); n++) {
     if(breakpoint[n]->addr->text().isEmpty()) {
       breakpoint[n]->setBreakpoint(addr, mode, source);
       return;
@@ -220,7 +246,7 @@ void BreakpointEditor::addBreakpoint(const string& breakpoint) {
 string BreakpointEditor::toStrings() const {
   string breakpoints;
   
-  for(unsigned n = 0; n < SNES::Debugger::Breakpoints; n++) {
+  for(unsigned n = 0; n < breakpoint.size(); n++) {
     if(!breakpoint[n]->addr->text().isEmpty()) {
       breakpoints << breakpoint[n]->toString() << "\n";
     }
@@ -40,7 +40,10 @@ class BreakpointEditor : public Window {
 
 public:
   QVBoxLayout *layout;
-  BreakpointItem *breakpoint[SNES::Debugger::Breakpoints];
+  QScrollArea *scrollArea;
+  QWidget *list;
+  QVBoxLayout *listLayout;
+  linear_vector<BreakpointItem*> breakpoint;
   QCheckBox *breakOnWDM;
 
   BreakpointEditor();
@@ -52,6 +55,10 @@ public:
 public slots:
   void toggle();
   void clear();
+  void expand();
+
+private:
+  void addItem();
 };
 
 extern BreakpointEditor *breakpointEditor;
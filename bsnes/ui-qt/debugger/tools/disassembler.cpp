@@ -44,12 +44,12 @@ Disassembler::Disassembler() {
 }
 
 void Disassembler::refresh(Source source, unsigned addr) {
-  uint8_t *usage;
-  unsigned mask;
-  if(source == CPU) { usage = SNES::cpu.usage; mask = (1 << 24) - 1; }
-  if(source == SMP) { usage = SNES::smp.usage; mask = (1 << 16) - 1; }
-  if(source == SA1) { usage = SNES::sa1.usage; mask = (1 << 24) - 1; }
-  if(source == SFX) { usage = SNES::superfx.usage; mask = (1 << 23) - 1; }
+  SNES::UsageMap *usage;
+  if(source == CPU) usage = &SNES::cpu.usage;
+  if(source == SMP) usage = &SNES::smp.usage;
+  if(source == SA1) usage = &SNES::sa1.usage;
+  if(source == SFX) usage = &SNES::superfx.usage;
+  unsigned mask = usage->size() - 1;
 
   int line[25];
   for(unsigned i = 0; i < 25; i++) line[i] = -1;
@@ -61,7 +61,7 @@ void Disassembler::refresh(Source source, unsigned addr) {
     if(base == -1) break;
 
     for(unsigned i = 1; i <= 4; i++) {
-      if(usage[(base - i) & mask] & 0x10) {
+      if(usage->read((base - i) & mask) & 0x10) {
         line[index] = base - i;
         break;
       }
@@ -73,7 +73,7 @@ void Disassembler::refresh(Source source, unsigned addr) {
     if(base == -1) break;
 
     for(unsigned i = 1; i <= 4; i++) {
-      if(usage[(base + i) & mask] & 0x10) {
+      if(usage->read((base + i) & mask) & 0x10) {
         line[index] = base + i;
         break;
       }
@@ -198,26 +198,38 @@ void MemoryEditor::nextUnknown() {
 void MemoryEditor::gotoPrevious(int type) {
   int offset = (int)editor->cursorPosition() / 2;
   bool found = false;
-  SNES::uint8 *usage;
+  SNES::UsageMap *usage;
   
   if (memorySource == SNES::Debugger::MemorySource::CPUBus) {
-    usage = SNES::cpu.usage;
+    usage = &SNES::cpu.usage;
   }
   else if (memorySource == SNES::Debugger::MemorySource::APUBus) {
-    usage = SNES::smp.usage;
+    usage = &SNES::smp.usage;
   }
   else if (memorySource == SNES::Debugger::MemorySource::CartROM) {
-    usage = SNES::cpu.cart_usage;
+    usage = &SNES::cpu.cart_usage;
   } 
   else if (memorySource == SNES::Debugger::MemorySource::SA1Bus) {
-    usage = SNES::sa1.usage;
+    usage = &SNES::sa1.usage;
   } 
   else if (memorySource == SNES::Debugger::MemorySource::SFXBus) {
-    usage = SNES::superfx.usage;
+    usage = &SNES::superfx.usage;
   } else return;
   
   while (--offset >= 0) {
-    bool foundHere = ((type && usage[offset] & type) || (!type && (usage[offset] & 0xf0) == 0));
+    if (!usage->allocated(offset)) {
+      // nothing has been recorded in this page, so every byte in it is unknown
+      bool foundHere = !type;
+      if (found && !foundHere) {
+        offset++; break;
+      }
+      found = found || foundHere;
+      offset &= ~(SNES::UsageMap::PageSize - 1);
+      continue;
+    }
+    
+    uint8_t flags = usage->read(offset);
+    bool foundHere = ((type && flags & type) || (!type && (flags & 0xf0) == 0));
     
     if (found && !foundHere) {
       offset++; break;
@@ -240,26 +252,35 @@ void MemoryEditor::gotoNext(int type) {
   int offset = (int)editor->cursorPosition() / 2;
   unsigned size = editor->editorSize();
   bool found = true;
-  SNES::uint8 *usage;
+  SNES::UsageMap *usage;
   
   if (memorySource == SNES::Debugger::MemorySource::CPUBus) {
-    usage = SNES::cpu.usage;
+    usage = &SNES::cpu.usage;
   }
   else if (memorySource == SNES::Debugger::MemorySource::APUBus) {
-    usage = SNES::smp.usage;
+    usage = &SNES::smp.usage;
   }
   else if (memorySource == SNES::Debugger::MemorySource::CartROM) {
-    usage = SNES::cpu.cart_usage;
+    usage = &SNES::cpu.cart_usage;
   }
   else if (memorySource == SNES::Debugger::MemorySource::SA1Bus) {
-    usage = SNES::sa1.usage;
+    usage = &SNES::sa1.usage;
   } 
   else if (memorySource == SNES::Debugger::MemorySource::SFXBus) {
-    usage = SNES::superfx.usage;
+    usage = &SNES::superfx.usage;
   } else return;
   
   while (++offset < size) {
-    bool foundHere = ((type && usage[offset] & type) || (!type && (usage[offset] & 0xf0) == 0));
+    if (!usage->allocated(offset)) {
+      bool foundHere = !type;
+      if (!found && foundHere) break;
+      found = foundHere;
+      offset |= SNES::UsageMap::PageSize - 1;
+      continue;
+    }
+    
+    uint8_t flags = usage->read(offset);
+    bool foundHere = ((type && flags & type) || (!type && (flags & 0xf0) == 0));
     
     if (!found && foundHere) {
       found = true; break;
@@ -438,19 +459,19 @@ void MemoryEditor::writer(unsigned addr, uint8_t data) {
 
 uint8_t MemoryEditor::usage(unsigned addr) {
   if (memorySource == SNES::Debugger::MemorySource::CPUBus && addr < 1 << 24) {
-    return SNES::cpu.usage[addr];
+    return SNES::cpu.usage.read(addr);
   }
   else if (memorySource == SNES::Debugger::MemorySource::APUBus && addr < 1 << 16) {
-    return SNES::smp.usage[addr];
+    return SNES::smp.usage.read(addr);
   }
   else if (memorySource == SNES::Debugger::MemorySource::CartROM && addr < 1 << 24) {
-    return SNES::cpu.cart_usage[addr];
+    return SNES::cpu.cart_usage.read(addr);
   }
   else if (memorySource == SNES::Debugger::MemorySource::SA1Bus && addr < 1 << 24) {
-    return SNES::sa1.usage[addr];
+    return SNES::sa1.usage.read(addr);
   }
   else if (memorySource == SNES::Debugger::MemorySource::SFXBus && addr < 1 << 23) {
-    return SNES::superfx.usage[addr];
+    return SNES::superfx.usage.read(addr);
   }
   
   return 0;
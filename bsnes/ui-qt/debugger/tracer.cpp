@@ -1,13 +1,24 @@
 #include "tracer.moc"
 Tracer *tracer;
 
+//binary trace log records are described by SNES::CPUcoreTrace
+enum : unsigned { TraceBufferSize = 1 << 20 };
+
 void Tracer::stepCpu() {
   if(traceCpu) {
     unsigned addr = SNES::cpu.regs.pc;
     if(!traceMask || !(traceMaskCPU[addr >> 3] & (0x80 >> (addr & 7)))) {
-      char text[256];
-      SNES::cpu.disassemble_opcode(text, addr, config().debugger.showHClocks);
-      tracefile.print(string() << text << "\n");
+      if(traceBinary) {
+        SNES::CPUcore::trace_t trace;
+        SNES::cpu.disassemble_trace(trace, addr);
+        uint8_t *record = traceReserve(1 + SNES::CPUcore::trace_t::Size);
+        record[0] = SNES::CPUcoreTrace::RecordCPU;
+        trace.store(record + 1);
+      } else {
+        char text[256];
+        SNES::cpu.disassemble_opcode(text, addr, config().debugger.showHClocks);
+        tracefile.print(string() << text << "\n");
+      }
     }
     traceMaskCPU[addr >> 3] |= 0x80 >> (addr & 7);
   }
@@ -19,7 +30,7 @@ void Tracer::stepSmp() {
     if(!traceMask || !(traceMaskSMP[addr >> 3] & (0x80 >> (addr & 7)))) {
       char text[256];
       SNES::smp.disassemble_opcode(text, addr);
-      tracefile.print(string() << text << "\n");
+      traceText(text);
     }
     traceMaskSMP[addr >> 3] |= 0x80 >> (addr & 7);
   }
@@ -29,9 +40,17 @@ void Tracer::stepSa1() {
   if(traceSa1) {
     unsigned addr = SNES::sa1.regs.pc;
     if(!traceMask || !(traceMaskSA1[addr >> 3] & (0x80 >> (addr & 7)))) {
-      char text[256];
-      SNES::sa1.disassemble_opcode(text, addr, config().debugger.showHClocks);
-      tracefile.print(string() << text << "\n");
+      if(traceBinary) {
+        SNES::CPUcore::trace_t trace;
+        SNES::sa1.disassemble_trace(trace, addr);
+        uint8_t *record = traceReserve(1 + SNES::CPUcore::trace_t::Size);
+        record[0] = SNES::CPUcoreTrace::RecordSA1;
+        trace.store(record + 1);
+      } else {
+        char text[256];
+        SNES::sa1.disassemble_opcode(text, addr, config().debugger.showHClocks);
+        tracefile.print(string() << text << "\n");
+      }
     }
     traceMaskSA1[addr >> 3] |= 0x80 >> (addr & 7);
   }
@@ -43,13 +62,77 @@ void Tracer::stepSfx() {
     if(!traceMask || !(traceMaskSFX[addr >> 3] & (0x80 >> (addr & 7)))) {
       char text[256];
       SNES::superfx.disassemble_opcode(text, addr);
-      tracefile.print(string() << text << "\n");
+      traceText(text);
     }
     traceMaskSFX[addr >> 3] |= 0x80 >> (addr & 7);
   }
 }
 
+bool Tracer::enabled() const {
+  return traceCpu || traceSmp || traceSa1 || traceSfx;
+}
+
+string Tracer::traceName(bool binary) {
+  string name = filepath(nall::basename(cartridge.fileName), config().path.data);
+  name << (binary ? "-trace.bin" : "-trace.log");
+  return name;
+}
+
+uint8_t* Tracer::traceReserve(unsigned length) {
+  if(traceBufferLength + length > TraceBufferSize) flushTrace();
+  uint8_t *data = traceBuffer + traceBufferLength;
+  traceBufferLength += length;
+  return data;
+}
+
+void Tracer::traceText(const char *text) {
+  if(traceBinary) {
+    unsigned length = strlen(text);
+    uint8_t *record = traceReserve(3 + length);
+    record[0] = SNES::CPUcoreTrace::RecordText;
+    record[1] = length >> 0;
+    record[2] = length >> 8;
+    memcpy(record + 3, text, length);
+  } else {
+    tracefile.print(string() << text << "\n");
+  }
+}
+
+void Tracer::flushTrace() {
+  if(traceBufferLength && tracefile.open()) tracefile.write(traceBuffer, traceBufferLength);
+  traceBufferLength = 0;
+}
+
+//converts the binary trace log of the loaded cartridge into the text log format
+void Tracer::renderTrace() {
+  if(!SNES::cartridge.loaded()) return;
+  if(traceBinary && tracefile.open()) {
+    flushTrace();
+    tracefile.flush();
+  }
+
+  filemap input;
+  if(!input.open(traceName(true), filemap::mode::read)) {
+    debugger->echo("No binary trace log found.<br>");
+    return;
+  }
+
+  file output;
+  if(!output.open(traceName(false), file::mode::write)) return;
+
+  SNES::CPUcoreTrace renderer;
+  if(!renderer.render(output, input.data(), input.size(), config().debugger.showHClocks)) {
+    output.close();
+    debugger->echo("Binary trace log is invalid.<br>");
+    return;
+  }
+
+  output.close();
+  debugger->echo(string() << "Rendered trace log to " << traceName(false) << "<br>");
+}
+
 void Tracer::resetTraceState() {
+  flushTrace();
   tracefile.close();
   setTraceState(traceCpu || traceSmp || traceSa1 || traceSfx);
   
@@ -60,10 +143,12 @@ void Tracer::resetTraceState() {
 
 void Tracer::setTraceState(bool state) {
   if(state && !tracefile.open() && SNES::cartridge.loaded()) {
-    string name = filepath(nall::basename(cartridge.fileName), config().path.data);
-    name << "-trace.log";
-    tracefile.open(name, file::mode::write);
+    traceBinary = config().debugger.binaryTrace;
+    if(tracefile.open(traceName(traceBinary), file::mode::write) && traceBinary) {
+      tracefile.write((const uint8_t*)SNES::CPUcoreTrace::signature, sizeof SNES::CPUcoreTrace::signature);
+    }
   } else if(!traceCpu && !traceSmp && !traceSa1 && !traceSfx && tracefile.open()) {
+    flushTrace();
     tracefile.close();
   }
 }
@@ -106,6 +191,9 @@ Tracer::Tracer() {
   traceSa1 = false;
   traceSfx = false;
   traceMask = false;
+  traceBinary = false;
+  traceBuffer = new uint8_t[TraceBufferSize];
+  traceBufferLength = 0;
 
   traceMaskCPU = new uint8_t[(1 << 24) >> 3]();
   traceMaskSMP = new uint8_t[(1 << 16) >> 3]();
@@ -123,5 +211,7 @@ Tracer::~Tracer() {
   delete[] traceMaskSMP;
   delete[] traceMaskSA1;
   delete[] traceMaskSFX;
+  flushTrace();
   if(tracefile.open()) tracefile.close();
+  delete[] traceBuffer;
 }
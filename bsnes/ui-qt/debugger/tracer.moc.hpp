@@ -6,6 +6,7 @@ public:
   void stepSmp();
   void stepSa1();
   void stepSfx();
+  bool enabled() const;
 
   Tracer();
   ~Tracer();
@@ -18,11 +19,19 @@ public slots:
   void setTraceMaskState(int);
   
   void resetTraceState();
+  void renderTrace();
 
 private:
   void setTraceState(bool);
+  string traceName(bool binary);
+  uint8_t* traceReserve(unsigned length);
+  void traceText(const char *text);
+  void flushTrace();
 
   file tracefile;
+  bool traceBinary;
+  uint8_t *traceBuffer;
+  unsigned traceBufferLength;
   bool traceCpu;
   bool traceSmp;
   bool traceSa1;
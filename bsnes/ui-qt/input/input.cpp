@@ -205,6 +205,7 @@ void InputMapper::bind() {
 }
 
 void InputMapper::poll() {
+  std::lock_guard<std::recursive_mutex> guard(lock);
   activeState = !activeState;
   input.poll(stateTable[activeState]);
 
@@ -229,6 +230,7 @@ void InputMapper::poll() {
 }
 
 void InputMapper::cache() {
+  std::lock_guard<std::recursive_mutex> guard(lock);
   if(config().input.focusPolicy == Configuration::Input::FocusPolicyIgnoreInput && !mainWindow->isActive()) {
     for(unsigned i = 0; i < size(); i++) {
       InputGroup &group = *((*this)[i]);
@@ -244,6 +246,39 @@ void InputMapper::cache() {
   }
 }
 
+//samples the input driver again and refreshes the controller port groups from it.
+//hotkeys and input events stay with poll(), which compares against its own previous state table
+void InputMapper::latch() {
+  std::lock_guard<std::recursive_mutex> guard(lock);
+  if(latched) return;
+  latched = true;
+
+  input.poll(latchTable);
+  //mouse axes are relative to the previous driver poll; add the motion already consumed by poll()
+  for(unsigned i = 0; i < Mouse::Count; i++) {
+    for(unsigned axis = 0; axis < Mouse::Axes; axis++) {
+      latchTable[mouse(i).axis(axis)] += stateTable[activeState][mouse(i).axis(axis)];
+    }
+  }
+
+  latching = true;
+  for(unsigned i = 0; i < size(); i++) {
+    InputGroup &group = *((*this)[i]);
+    if(group.category == InputCategory::Port1 || group.category == InputCategory::Port2) {
+      group.poll();
+    }
+  }
+  latching = false;
+
+  cache();
+}
+
+//called once per emulated frame; the next latch samples the driver again
+void InputMapper::unlatch() {
+  std::lock_guard<std::recursive_mutex> guard(lock);
+  latched = false;
+}
+
 int16_t InputMapper::status(bool port, SNES::Input::Device device, unsigned index, unsigned id) {
   int16_t result = 0;
 
@@ -268,7 +303,7 @@ string InputMapper::modifierString() const {
   return name;
 }
 
-int16_t InputMapper::state(uint16_t scancode) const { return stateTable[activeState][scancode]; }
+int16_t InputMapper::state(uint16_t scancode) const { return latching ? latchTable[scancode] : stateTable[activeState][scancode]; }
 int16_t InputMapper::previousState(uint16_t scancode) const { return stateTable[!activeState][scancode]; }
 unsigned InputMapper::distance(uint16_t scancode) const { return abs(state(scancode) - previousState(scancode)); }
 
@@ -283,5 +318,9 @@ InputMapper::InputMapper() : port1(0), port2(0) {
   activeState = 0;
   for(unsigned i = 0; i < Scancode::Limit; i++) {
     stateTable[0][i] = stateTable[1][i] = 0;
+    latchTable[i] = 0;
   }
+
+  latched = false;
+  latching = false;
 }
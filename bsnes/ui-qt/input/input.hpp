@@ -72,10 +72,19 @@ struct InputMapper : public array<InputGroup*> {
   int16_t stateTable[2][Scancode::Limit];
   unsigned modifier;
 
+  //controller state sampled when the game latches the ports (config().input.pollOnLatch);
+  //at most once per emulated frame, so turbo cadence is unchanged
+  bool latched;
+  bool latching;
+  int16_t latchTable[Scancode::Limit];
+  std::recursive_mutex lock;
+
   void calibrate();
   void bind();
   void poll();
   void cache();
+  void latch();
+  void unlatch();
   int16_t status(bool, SNES::Input::Device, unsigned, unsigned);
 
   string modifierString() const;
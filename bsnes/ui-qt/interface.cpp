@@ -22,6 +22,11 @@ void Interface::video_refresh(const uint16_t *data, unsigned width, unsigned hei
     if(!overscan) data -= 7 * 1024;
   }
 
+  frameData = data;
+  framePitch = pitch;
+  frameWidth = width;
+  frameHeight = height;
+
   if(saveScreenshot == true && config().video.unfilteredScreenshot == true) {
     captureScreenshot(filter.renderUnfilteredScreenshot(data, pitch, width, height));
   }
@@ -43,6 +48,7 @@ void Interface::video_refresh(const uint16_t *data, unsigned width, unsigned hei
     data += cropTop * (pitch >> 1) + cropLeft;
     filter.render(output, outpitch, data, pitch, width, height);
     video.unlock();
+    pacer.present();
     video.refresh();
 
     if(saveScreenshot == true && config().video.unfilteredScreenshot == false) {
@@ -68,11 +74,26 @@ void Interface::video_refresh(const uint16_t *data, unsigned width, unsigned hei
 
 void Interface::audio_sample(uint16_t left, uint16_t right) {
   if(config().audio.mute) left = right = 0;
-  audio.sample(left, right);
+  pacer.samples++;
+  if(pacer.active && config().audio.synchronize) {
+    int64_t start = FramePacer::time();
+    audio.sample(left, right);
+    pacer.blocked += FramePacer::time() - start;
+  } else {
+    audio.sample(left, right);
+  }
 }
 
 void Interface::input_poll() {
-  mapper().cache();
+  if(config().input.pollOnLatch) {
+    mapper().unlatch();
+  } else {
+    mapper().cache();
+  }
+}
+
+void Interface::input_latch() {
+  if(config().input.pollOnLatch) mapper().latch();
 }
 
 int16_t Interface::input_poll(bool port, SNES::Input::Device device, unsigned index, unsigned id) {
@@ -121,4 +142,6 @@ void Interface::captureSPC() {
 
 Interface::Interface() {
   saveScreenshot = false;
+  frameData = 0;
+  framePitch = frameWidth = frameHeight = 0;
 }
@@ -4,6 +4,7 @@ public:
   void video_refresh(const uint16_t *data, unsigned width, unsigned height);
   void audio_sample(uint16_t left, uint16_t right);
   void input_poll();
+  void input_latch();
   int16_t input_poll(bool port, SNES::Input::Device device, unsigned index, unsigned id);
   void message(const string &text);
 
@@ -11,6 +12,11 @@ public:
   void captureScreenshot(const QImage&);
   void captureSPC();
   bool saveScreenshot;
+
+  //last frame presented, after overscan adjustment (used for save state thumbnails)
+  const uint16_t *frameData;
+  unsigned framePitch, frameWidth, frameHeight;
+
   bool framesUpdated;
   unsigned framesExecuted;
 };
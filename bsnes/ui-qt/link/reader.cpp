@@ -21,11 +21,15 @@ Reader::Reader() {
   if(open("snesreader")) {
     supported = sym("snesreader_supported");
     load = sym("snesreader_load");
+    list = sym("snesreader_list");
+    extract = sym("snesreader_extract");
   }
 
   if(!supported || !load) {
     supported = { &Reader::direct_supported, this };
     load = { &Reader::direct_load, this };
+    list.reset();
+    extract.reset();
   }
 
   compressionList = supported();
@@ -6,6 +6,10 @@ public:
   function<const char* ()> supported;
   function<bool (string&, uint8_t*&, unsigned&)> load;
 
+  //non-interactive archive access, used by the cartridge index; unset when snesreader lacks it
+  function<bool (const char*, lstring&)> list;
+  function<bool (const char*, const char*, uint8_t*&, unsigned&)> extract;
+
   const char* direct_supported();
   bool direct_load(string&, uint8_t*&, unsigned&);
 
@@ -115,9 +115,17 @@ AdvancedSettingsWindow::AdvancedSettingsWindow() {
   rewindEnable = new QCheckBox("Enable rewind support");
   layout->addWidget(rewindEnable);
 
+  framePacing = new QCheckBox("Pace frames with a high-resolution timer");
+  framePacing->setToolTip("Smoother presentation on high refresh rate displays; has no effect while video sync is enabled");
+  layout->addWidget(framePacing);
+
   allowInvalidInput = new QCheckBox("Allow up+down / left+right combinations");
   layout->addWidget(allowInvalidInput);
 
+  pollOnLatch = new QCheckBox("Poll controllers when the game reads them");
+  pollOnLatch->setToolTip("Reduces input latency by up to one frame");
+  layout->addWidget(pollOnLatch);
+
   useCommonDialogs = new QCheckBox("Use native OS file dialogs");
   layout->addWidget(useCommonDialogs);
 
@@ -136,7 +144,9 @@ AdvancedSettingsWindow::AdvancedSettingsWindow() {
   connect(focusAllow, SIGNAL(pressed()), this, SLOT(allowInputWithoutFocus()));
   connect(autoSaveEnable, SIGNAL(stateChanged(int)), this, SLOT(toggleAutoSaveEnable()));
   connect(rewindEnable, SIGNAL(stateChanged(int)), this, SLOT(toggleRewindEnable()));
+  connect(framePacing, SIGNAL(stateChanged(int)), this, SLOT(toggleFramePacing()));
   connect(allowInvalidInput, SIGNAL(stateChanged(int)), this, SLOT(toggleAllowInvalidInput()));
+  connect(pollOnLatch, SIGNAL(stateChanged(int)), this, SLOT(togglePollOnLatch()));
   connect(useCommonDialogs, SIGNAL(stateChanged(int)), this, SLOT(toggleUseCommonDialogs()));
 }
 
@@ -174,7 +184,9 @@ void AdvancedSettingsWindow::initializeUi() {
 
   autoSaveEnable->setChecked(config().system.autoSaveMemory);
   rewindEnable->setChecked(config().system.rewindEnabled);
+  framePacing->setChecked(config().system.framePacing);
   allowInvalidInput->setChecked(config().input.allowInvalidInput);
+  pollOnLatch->setChecked(config().input.pollOnLatch);
   useCommonDialogs->setChecked(config().diskBrowser.useCommonDialogs);
 }
 
@@ -210,10 +222,19 @@ void AdvancedSettingsWindow::toggleRewindEnable() {
   state.resetHistory();
 }
 
+void AdvancedSettingsWindow::toggleFramePacing() {
+  config().system.framePacing = framePacing->isChecked();
+  pacer.reset();
+}
+
 void AdvancedSettingsWindow::toggleAllowInvalidInput() {
   config().input.allowInvalidInput = allowInvalidInput->isChecked();
 }
 
+void AdvancedSettingsWindow::togglePollOnLatch() {
+  config().input.pollOnLatch = pollOnLatch->isChecked();
+}
+
 void AdvancedSettingsWindow::toggleUseCommonDialogs() {
   config().diskBrowser.useCommonDialogs = useCommonDialogs->isChecked();
 }
@@ -37,7 +37,9 @@ public:
   QLabel *miscTitle;
   QCheckBox *autoSaveEnable;
   QCheckBox *rewindEnable;
+  QCheckBox *framePacing;
   QCheckBox *allowInvalidInput;
+  QCheckBox *pollOnLatch;
   QCheckBox *useCommonDialogs;
 
   void initializeUi();
@@ -57,7 +59,9 @@ public slots:
   void allowInputWithoutFocus();
   void toggleAutoSaveEnable();
   void toggleRewindEnable();
+  void toggleFramePacing();
   void toggleAllowInvalidInput();
+  void togglePollOnLatch();
   void toggleUseCommonDialogs();
 };
 
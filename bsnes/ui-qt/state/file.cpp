@@ -0,0 +1,233 @@
+//runs the system to a save point, then snapshots its state and a downscaled copy of the last frame
+void StateFile::capture() {
+  SNES::system.runtosave();
+  state = SNES::system.serialize();
+  memcpy(preamble, state.data(), PreambleSize);
+  timestamp = time(0);
+  description = "";
+
+  hasThumbnail = interface.frameData != 0;
+  if(hasThumbnail == false) return;
+  unsigned pitch = interface.framePitch >> 1;
+  for(unsigned y = 0; y < ThumbnailHeight; y++) {
+    const uint16_t *line = interface.frameData + (y * interface.frameHeight / ThumbnailHeight) * pitch;
+    for(unsigned x = 0; x < ThumbnailWidth; x++) {
+      thumbnail[y * ThumbnailWidth + x] = line[x * interface.frameWidth / ThumbnailWidth] & 0x7fff;
+    }
+  }
+}
+
+bool StateFile::valid() const {
+  uint32_t signature = preamble[0] | (preamble[1] << 8) | (preamble[2] << 16) | (preamble[3] << 24);
+  uint32_t version = preamble[4] | (preamble[5] << 8) | (preamble[6] << 16) | (preamble[7] << 24);
+  if(signature != SNES::Info::SerializerSignature) return false;
+  if(version != SNES::Info::SerializerVersion) return false;
+  char profile[16];
+  memcpy(profile, preamble + 12, 16);
+  profile[15] = 0;
+  return strcmp(profile, SNES::Info::Profile) == 0;
+}
+
+QImage StateFile::thumbnailImage() const {
+  if(hasThumbnail == false) return QImage();
+  QImage image(ThumbnailWidth, ThumbnailHeight, QImage::Format_RGB32);
+  for(unsigned y = 0; y < ThumbnailHeight; y++) {
+    QRgb *line = (QRgb*)image.scanLine(y);
+    for(unsigned x = 0; x < ThumbnailWidth; x++) line[x] = filter.colortable[thumbnail[y * ThumbnailWidth + x]];
+  }
+  return image;
+}
+
+void StateFile::encode(uint8_t *&data, unsigned &size) const {
+  unsigned thumbnailSize = hasThumbnail ? ThumbnailWidth * ThumbnailHeight * 2 : 0;
+  unsigned descriptionSize = description.length();
+  data = new uint8_t[96 + descriptionSize + lz4::bound(thumbnailSize) + lz4::bound(state.capacity())];
+  uint8_t *p = data;
+
+  auto write = [&](uint64_t value, unsigned length) {
+    while(length--) { *p++ = value; value >>= 8; }
+  };
+
+  auto section = [&](unsigned id, const uint8_t *input, unsigned length) {
+    write(id, 4);
+    write(length, 4);
+    uint8_t *packed = p;
+    p += 4;
+    unsigned packedSize = lz4::encode(p, input, length);
+    p = packed;
+    write(packedSize, 4);
+    p += packedSize;
+  };
+
+  write(Signature, 4);
+  write(Version, 4);
+  memcpy(p, preamble, PreambleSize);
+  p += PreambleSize;
+  write(timestamp, 8);
+
+  write(hasThumbnail ? 3 : 2, 4);
+  if(hasThumbnail) {
+    uint8_t *buffer = new uint8_t[thumbnailSize];
+    for(unsigned i = 0; i < ThumbnailWidth * ThumbnailHeight; i++) {
+      buffer[i * 2 + 0] = thumbnail[i];
+      buffer[i * 2 + 1] = thumbnail[i] >> 8;
+    }
+    section(SectionThumbnail, buffer, thumbnailSize);
+    delete[] buffer;
+  }
+  section(SectionState, state.data(), state.capacity());
+
+  //stored last and unpacked (packed size = length), see replaceDescription()
+  write(SectionDescription, 4);
+  write(descriptionSize, 4);
+  write(descriptionSize, 4);
+  memcpy(p, (const char*)description, descriptionSize);
+  p += descriptionSize;
+
+  size = p - data;
+}
+
+//withState = false skips inflating the system state, for slot listings
+bool StateFile::decode(const uint8_t *data, unsigned size, bool withState) {
+  timestamp = 0;
+  description = "";
+  hasThumbnail = false;
+  state = serializer();
+
+  const uint8_t *p = data, *end = data + size;
+  auto available = [&](unsigned length) { return (unsigned)(end - p) >= length; };
+  auto read = [&](unsigned length) -> uint64_t {
+    uint64_t value = 0;
+    for(unsigned n = 0; n < length; n++) value |= (uint64_t)*p++ << (n << 3);
+    return value;
+  };
+
+  if(!available(8)) return false;
+  if(read(4) != Signature) {
+    //raw serializer image: the preamble is followed by a fixed-size description field
+    if(size < PreambleSize + DescriptionSize) return false;
+    memcpy(preamble, data, PreambleSize);
+    char text[DescriptionSize];
+    memcpy(text, data + PreambleSize, DescriptionSize);
+    text[DescriptionSize - 1] = 0;
+    description = text;
+    if(withState) state = serializer(data, size);
+    return true;
+  }
+  if(read(4) != Version) return false;
+
+  if(!available(PreambleSize + 12)) return false;
+  memcpy(preamble, p, PreambleSize);
+  p += PreambleSize;
+  timestamp = read(8);
+
+  bool hasState = false;
+  unsigned sections = read(4);
+  while(sections--) {
+    if(!available(12)) return false;
+    unsigned id = read(4);
+    unsigned length = read(4);
+    unsigned packedSize = read(4);
+    if(!available(packedSize)) return false;
+
+    if(id == SectionThumbnail && length == ThumbnailWidth * ThumbnailHeight * 2) {
+      uint8_t *buffer = new uint8_t[length];
+      hasThumbnail = lz4::decode(buffer, length, p, packedSize);
+      for(unsigned i = 0; hasThumbnail && i < ThumbnailWidth * ThumbnailHeight; i++) {
+        thumbnail[i] = buffer[i * 2 + 0] | (buffer[i * 2 + 1] << 8);
+      }
+      delete[] buffer;
+    } else if(id == SectionState && withState) {
+      uint8_t *buffer = new uint8_t[length];
+      hasState = lz4::decode(buffer, length, p, packedSize);
+      if(hasState) state = serializer(buffer, length);
+      delete[] buffer;
+      if(!hasState) return false;
+    } else if(id == SectionDescription && packedSize == length) {
+      char *text = new char[length + 1];
+      memcpy(text, p, length);
+      text[length] = 0;
+      description = text;
+      delete[] text;
+    }
+
+    p += packedSize;
+  }
+
+  return withState == false || hasState;
+}
+
+bool StateFile::save(const string &filename) const {
+  file fp;
+  if(fp.open(filename, file::mode::write) == false) return false;
+  uint8_t *data;
+  unsigned size;
+  encode(data, size);
+  fp.write(data, size);
+  fp.close();
+  delete[] data;
+  return true;
+}
+
+bool StateFile::load(const string &filename, bool withState) {
+  file fp;
+  if(fp.open(filename, file::mode::read) == false) return false;
+  unsigned size = fp.size();
+  uint8_t *data = new uint8_t[size];
+  fp.read(data, size);
+  fp.close();
+  bool result = decode(data, size, withState);
+  delete[] data;
+  return result;
+}
+
+//builds a copy of an encoded state with another description; the packed sections are copied
+//as they are, so this costs no compression
+bool StateFile::replaceDescription(const uint8_t *data, unsigned size, const string &description, uint8_t *&output, unsigned &outputSize) {
+  enum : unsigned { HeaderSize = 8 + PreambleSize + 8 };
+  auto read = [&](unsigned offset) -> uint32_t {
+    return data[offset] | (data[offset + 1] << 8) | (data[offset + 2] << 16) | (data[offset + 3] << 24);
+  };
+  if(size < HeaderSize + 4 || read(0) != Signature || read(4) != Version) return false;
+
+  unsigned descriptionSize = description.length();
+  output = new uint8_t[size + 12 + descriptionSize];
+  uint8_t *p = output;
+  auto write = [&](uint32_t value) {
+    for(unsigned n = 0; n < 4; n++) { *p++ = value; value >>= 8; }
+  };
+
+  memcpy(p, data, HeaderSize);
+  p += HeaderSize + 4;
+  unsigned offset = HeaderSize + 4, sections = 0;
+  for(unsigned count = read(HeaderSize); count; count--) {
+    if(size - offset < 12 || size - offset - 12 < read(offset + 8)) {
+      delete[] output;
+      return false;
+    }
+    unsigned length = 12 + read(offset + 8);
+    if(read(offset) != SectionDescription) {
+      memcpy(p, data + offset, length);
+      p += length;
+      sections++;
+    }
+    offset += length;
+  }
+
+  write(SectionDescription);
+  write(descriptionSize);
+  write(descriptionSize);
+  memcpy(p, (const char*)description, descriptionSize);
+  p += descriptionSize;
+
+  outputSize = p - output;
+  p = output + HeaderSize;
+  write(sections + 1);
+  return true;
+}
+
+StateFile::StateFile() {
+  memset(preamble, 0, sizeof preamble);
+  timestamp = 0;
+  hasThumbnail = false;
+}
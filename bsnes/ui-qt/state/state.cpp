@@ -1,29 +1,25 @@
 #include "../ui-base.hpp"
 State state;
 
+#include "file.cpp"
+
 bool State::save(unsigned slot) {
   if(!allowed()) {
     utility.showMessage("Cannot save state.");
     return false;
   }
 
-  SNES::system.runtosave();
-  serializer state = SNES::system.serialize();
-
-  file fp;
-  bool result = false;
-  if(fp.open(name(slot), file::mode::write)) {
-    fp.write(state.data(), state.size());
-    fp.close();
-    result = true;
-  }
+  StateFile *state = new StateFile;
+  state->capture();
 
-  if(result) {
-    utility.showMessage(string() << "State " << (slot + 1) << " saved.");
-  } else {
-    utility.showMessage(string() << "Failed to save state " << (slot + 1) << ".");
-  }
-  return result;
+  //compression and file I/O happen off the emulation thread; the frame does not wait on disk
+  string filename = name(slot);
+  write([state, filename] {
+    bool result = state->save(filename);
+    delete state;
+    return result;
+  }, string() << "State " << (slot + 1) << " saved.", string() << "Failed to save state " << (slot + 1) << ".");
+  return true;
 }
 
 bool State::load(unsigned slot) {
@@ -32,17 +28,9 @@ bool State::load(unsigned slot) {
     return false;
   }
 
-  file fp;
-  bool result = false;
-  if(fp.open(name(slot), file::mode::read)) {
-    unsigned size = fp.size();
-    uint8_t *data = new uint8_t[size];
-    fp.read(data, size);
-    fp.close();
-    serializer state(data, size);
-    delete[] data;
-    result = SNES::system.unserialize(state);
-  }
+  finishWrite();
+  StateFile state;
+  bool result = state.load(name(slot)) && SNES::system.unserialize(state.state);
 
   if(result) {
     utility.showMessage(string() << "State " << (slot + 1) << " loaded.");
@@ -53,6 +41,37 @@ bool State::load(unsigned slot) {
   return result;
 }
 
+void State::write(const function<bool ()> &job, const string &success, const string &failure) {
+  finishWrite();
+  writerDone = false;
+  writerSuccess = success;
+  writerFailure = failure;
+  writer = std::thread([this, job] {
+    bool result = job();
+    std::lock_guard<std::mutex> guard(writerLock);
+    writerResult = result;
+    writerDone = true;
+  });
+}
+
+//reports a completed background write, if any
+void State::poll() {
+  if(!writer.joinable()) return;
+  bool done;
+  {
+    std::lock_guard<std::mutex> guard(writerLock);
+    done = writerDone;
+  }
+  if(done) finishWrite();
+}
+
+void State::finishWrite() {
+  if(!writer.joinable()) return;
+  writer.join();
+  const string &message = writerResult ? writerSuccess : writerFailure;
+  if(message != "") utility.showMessage(message);
+}
+
 void State::frame() {
   if(!allowed()) return;
   if(!config().system.rewindEnabled) return;
@@ -87,12 +106,15 @@ bool State::rewind() {
 
 State::State() {
   active = 0;
+  writerDone = false;
+  writerResult = false;
   historySize = 120;
   history = new serializer[historySize];
   for(unsigned i = 0; i < historySize; i++) history[i] = 0;
 }
 
 State::~State() {
+  if(writer.joinable()) writer.join();
   delete[] history;
 }
 
@@ -1,8 +1,46 @@
+//save state container: an uncompressed header (serializer preamble, timestamp) followed by
+//sections. the thumbnail and system state are each LZ4-compressed independently, so that slot
+//listings can read them without inflating the full state; the description is stored as is,
+//so that replaceDescription() can rewrite it without repacking the other sections.
+//raw serializer images written by earlier versions are still accepted by decode().
+class StateFile {
+public:
+  enum : unsigned { Signature = 0x5a545342, Version = 2 };  //'BSTZ'
+  enum : unsigned { PreambleSize = 28, DescriptionSize = 512 };
+  enum : unsigned { ThumbnailWidth = 128, ThumbnailHeight = 112 };
+  enum Section : unsigned { SectionThumbnail = 1, SectionState = 2, SectionDescription = 3 };
+
+  uint8_t preamble[PreambleSize];  //signature, version, CRC32 and profile of the serialized state
+  uint64_t timestamp;
+  string description;
+  bool hasThumbnail;
+  uint16_t thumbnail[ThumbnailWidth * ThumbnailHeight];
+  serializer state;
+
+  void capture();
+  bool valid() const;
+  QImage thumbnailImage() const;
+
+  void encode(uint8_t *&data, unsigned &size) const;
+  bool decode(const uint8_t *data, unsigned size, bool withState = true);
+  bool save(const string &filename) const;
+  bool load(const string &filename, bool withState = true);
+  static bool replaceDescription(const uint8_t *data, unsigned size, const string &description, uint8_t *&output, unsigned &outputSize);
+
+  StateFile();
+};
+
 class State {
 public:
   unsigned active;
   bool save(unsigned);
   bool load(unsigned);
+  void poll();
+
+  //runs job on the writer thread once the previous one has finished; poll() shows the message
+  //for its result, if not empty. data that a job uses must not change before finishWrite()
+  void write(const function<bool ()> &job, const string &success, const string &failure);
+  void finishWrite();
 
   void frame();
   void resetHistory();
@@ -12,6 +50,14 @@ public:
   ~State();
 
 private:
+  //quick saves and state archives are compressed and written on a worker thread
+  std::thread writer;
+  std::mutex writerLock;
+  bool writerDone;
+  bool writerResult;
+  string writerSuccess;
+  string writerFailure;
+
   serializer *history;
   unsigned historySize;
   unsigned historyIndex;
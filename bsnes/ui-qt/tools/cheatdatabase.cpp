@@ -0,0 +1,215 @@
+CheatDatabase cheatDatabase;
+
+//on-disk format: signature, version, cheats.xml modification time and size, entry count;
+//then count index entries (SHA-256, record offset) sorted by SHA-256, followed by the records.
+//a record is the null-terminated name, a 32-bit cheat count, and each cheat's description and code.
+//integers are little-endian.
+
+static uint64_t cheatDatabaseRead(const uint8_t *p, unsigned length) {
+  uint64_t value = 0;
+  for(unsigned n = 0; n < length; n++) value |= (uint64_t)p[n] << (n << 3);
+  return value;
+}
+
+//maps the compiled database, rebuilding it first if cheats.xml has changed; cheap when already up to date
+bool CheatDatabase::open(const string &xmlFilename) {
+  QFileInfo fileInfo(QString::fromUtf8(xmlFilename));
+  if(!fileInfo.isFile()) {
+    close();
+    return false;
+  }
+#if QT_VERSION >= 0x050800
+  uint64_t mtime = fileInfo.lastModified().toSecsSinceEpoch();
+#else
+  uint64_t mtime = fileInfo.lastModified().toTime_t();
+#endif
+  uint64_t size = fileInfo.size();
+
+  if(index && cheatDatabaseRead(map.data() + 8, 8) == mtime && cheatDatabaseRead(map.data() + 16, 8) == size) return true;
+  close();
+
+  filename = "cheats.bin";
+  application.locateFile(filename, true);
+
+  if(map.open(filename, filemap::mode::read) && valid(mtime, size)) return true;
+  map.close();
+
+  if(compile(xmlFilename, mtime, size) == false) return false;
+  if(map.open(filename, filemap::mode::read) && valid(mtime, size)) return true;
+  close();
+  return false;
+}
+
+void CheatDatabase::close() {
+  map.close();
+  index = 0;
+  count = 0;
+}
+
+//sha256 is the hexadecimal digest from SNES::Cartridge::sha256()
+bool CheatDatabase::find(const char *sha256, Entry &entry) const {
+  if(!index || strlen(sha256) != 64) return false;
+
+  uint8_t key[32];
+  for(unsigned n = 0; n < 32; n++) {
+    char digits[3] = { sha256[n * 2 + 0], sha256[n * 2 + 1], 0 };
+    key[n] = hex(digits);
+  }
+
+  //lower bound, so that duplicate entries resolve to the first one in cheats.xml
+  unsigned lo = 0, hi = count;
+  while(lo < hi) {
+    unsigned mid = (lo + hi) >> 1;
+    if(memcmp(index + mid * IndexSize, key, 32) < 0) lo = mid + 1;
+    else hi = mid;
+  }
+  if(lo == count || memcmp(index + lo * IndexSize, key, 32)) return false;
+
+  const char *record = (const char*)map.data() + cheatDatabaseRead(index + lo * IndexSize + 32, 4);
+  entry.name = record;
+  record += strlen(record) + 1;
+  entry.count = cheatDatabaseRead((const uint8_t*)record, 4);
+  entry.cheats = record + 4;
+  return true;
+}
+
+//returns the string at cheat and advances past it
+const char* CheatDatabase::next(const char *&cheat) {
+  const char *result = cheat;
+  cheat += strlen(cheat) + 1;
+  return result;
+}
+
+//the mapping is only trusted after checking that every index entry and record lies within it
+bool CheatDatabase::valid(uint64_t mtime, uint64_t size) {
+  const uint8_t *data = map.data();
+  unsigned length = map.size();
+  if(length < HeaderSize) return false;
+  if(cheatDatabaseRead(data +  0, 4) != Signature) return false;
+  if(cheatDatabaseRead(data +  4, 4) != Version) return false;
+  if(cheatDatabaseRead(data +  8, 8) != mtime) return false;
+  if(cheatDatabaseRead(data + 16, 8) != size) return false;
+
+  unsigned entries = cheatDatabaseRead(data + 24, 4);
+  if(entries > (length - HeaderSize) / IndexSize) return false;
+  unsigned recordBase = HeaderSize + entries * IndexSize;
+  if(data[length - 1] != 0) return false;  //every string scan stops inside the mapping
+
+  for(unsigned i = 0; i < entries; i++) {
+    unsigned offset = cheatDatabaseRead(data + HeaderSize + i * IndexSize + 32, 4);
+    if(offset < recordBase || offset >= length) return false;
+    const char *p = (const char*)data + offset;
+    p += strlen(p) + 1;
+    if((unsigned)((const char*)data + length - p) < 4) return false;
+    unsigned cheats = cheatDatabaseRead((const uint8_t*)p, 4);
+    p += 4;
+    for(unsigned n = 0; n < cheats * 2; n++) {
+      if(p >= (const char*)data + length) return false;
+      p += strlen(p) + 1;
+    }
+  }
+
+  index = data + HeaderSize;
+  count = entries;
+  return true;
+}
+
+bool CheatDatabase::compile(const string &xmlFilename, uint64_t mtime, uint64_t size) {
+  string text;
+  if(text.readfile(xmlFilename) == false) return false;
+  xml_element document = xml_parse(text);
+
+  struct Key {
+    uint8_t sha256[32];
+    unsigned offset;
+    //nall::sort is not stable in practice; ordering duplicates by offset keeps them in cheats.xml order
+    bool operator<(const Key &source) const {
+      int order = memcmp(sha256, source.sha256, 32);
+      return order < 0 || (order == 0 && offset < source.offset);
+    }
+  };
+  array<Key> keys;
+  array<uint8_t> records;
+
+  auto write = [&](array<uint8_t> &buffer, uint64_t value, unsigned length) {
+    while(length--) { buffer.append(value); value >>= 8; }
+  };
+  auto append = [&](const char *value) {
+    unsigned length = strlen(value) + 1;
+    unsigned offset = records.size();
+    memcpy(records.get(offset + length) + offset, value, length);
+  };
+
+  foreach(root, document.element) {
+    if(root.name != "database") continue;
+    foreach(cartridge, root.element) {
+      if(cartridge.name != "cartridge") continue;
+
+      string sha256;
+      foreach(attribute, cartridge.attribute) {
+        if(attribute.name == "sha256") sha256 = attribute.content;
+      }
+      if(sha256.length() != 64) continue;
+      const char *digest = sha256;
+
+      Key key;
+      for(unsigned n = 0; n < 32; n++) {
+        char digits[3] = { digest[n * 2 + 0], digest[n * 2 + 1], 0 };
+        key.sha256[n] = hex(digits);
+      }
+      key.offset = records.size();
+      keys.append(key);
+
+      string name;
+      unsigned cheats = 0;
+      foreach(node, cartridge.element) {
+        if(node.name == "name") name = node.parse();
+        if(node.name == "cheat") cheats++;
+      }
+      append(name);
+      write(records, cheats, 4);
+
+      foreach(node, cartridge.element) {
+        if(node.name != "cheat") continue;
+        string description = "<undefined>";
+        string code = "";
+        foreach(leaf, node.element) {
+          if(leaf.name == "description") {
+            description = leaf.parse();
+          } else if(leaf.name == "code") {
+            if(code != "") code << "+";
+            code << leaf.content;
+          }
+        }
+        append(description);
+        append(code);
+      }
+    }
+  }
+
+  sort(keys.get(), keys.size());
+
+  array<uint8_t> header;
+  write(header, Signature, 4);
+  write(header, Version, 4);
+  write(header, mtime, 8);
+  write(header, size, 8);
+  write(header, keys.size(), 4);
+  unsigned recordBase = HeaderSize + keys.size() * IndexSize;
+  for(unsigned i = 0; i < keys.size(); i++) {
+    for(unsigned n = 0; n < 32; n++) header.append(keys[i].sha256[n]);
+    write(header, recordBase + keys[i].offset, 4);
+  }
+
+  file fp;
+  if(fp.open(filename, file::mode::write) == false) return false;
+  fp.write(header.get(), header.size());
+  fp.write(records.get(), records.size());
+  fp.close();
+  return true;
+}
+
+CheatDatabase::CheatDatabase() {
+  index = 0;
+  count = 0;
+}
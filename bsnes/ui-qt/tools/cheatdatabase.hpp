@@ -0,0 +1,32 @@
+//compiled form of cheats.xml, memory-mapped for lookups by cartridge SHA-256.
+//the file is rebuilt whenever cheats.xml changes modification time or size;
+//lookups are a binary search over the sorted index and return pointers into the mapping.
+class CheatDatabase {
+public:
+  struct Entry {
+    const char *name;
+    unsigned count;
+    const char *cheats;  //count pairs of null-terminated strings: description, then codes joined by '+'
+  };
+
+  bool open(const string &xmlFilename);
+  void close();
+  bool find(const char *sha256, Entry &entry) const;
+  static const char* next(const char *&cheat);
+
+  CheatDatabase();
+
+private:
+  enum : unsigned { Signature = 0x44435342, Version = 1 };  //'BSCD'
+  enum : unsigned { HeaderSize = 28, IndexSize = 36 };
+
+  bool valid(uint64_t mtime, uint64_t size);
+  bool compile(const string &xmlFilename, uint64_t mtime, uint64_t size);
+
+  string filename;
+  filemap map;
+  const uint8_t *index;
+  unsigned count;
+};
+
+extern CheatDatabase cheatDatabase;
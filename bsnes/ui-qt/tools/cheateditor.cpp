@@ -238,24 +238,11 @@ void CheatEditorWindow::toggleCheatEnable() {
 }
 
 void CheatEditorWindow::findCheatCodes() {
-  string data;
-  
-  QFile file(application.cheatsFilename);
-  if(file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-    data = file.readAll().constData();
-    file.close();
-  }
-
-  if(auto position = strpos(data, SNES::cartridge.sha256())) {
-    const char *block = (const char*)data + position() - 19;
-    if(position = strpos(block, "</cartridge>")) {
-      xml_element document = xml_parse(substr(block, 0, position() + 12));
-      if(document.element.size() == 0) return;
-
-      cheatImportWindow->refresh(document.element[0]);
-      cheatImportWindow->show();
-      return;
-    }
+  CheatDatabase::Entry entry;
+  if(cheatDatabase.open(application.cheatsFilename) && cheatDatabase.find(SNES::cartridge.sha256(), entry)) {
+    cheatImportWindow->refresh(entry);
+    cheatImportWindow->show();
+    return;
   }
 
   audio.clear();
@@ -283,31 +270,19 @@ void CheatEditorWindow::clearSelected() {
 //CheatImportWindow
 //=================
 
-void CheatImportWindow::refresh(xml_element &root) {
+void CheatImportWindow::refresh(const CheatDatabase::Entry &entry) {
   list->clear();
+  title->setText(string() << "<b>Name:</b> " << entry.name);
 
-  foreach(node, root.element) {
-    if(node.name == "name") {
-      title->setText(string() << "<b>Name:</b> " << node.parse());
-    } else if(node.name == "cheat") {
-      string description = "<undefined>";
-      string code = "";
-
-      foreach(leaf, node.element) {
-        if(leaf.name == "description") {
-          description = leaf.parse();
-        } else if(leaf.name == "code") {
-          if(code != "") code << "+";
-          code << leaf.content;
-        }
-      }
+  const char *cheat = entry.cheats;
+  for(unsigned i = 0; i < entry.count; i++) {
+    const char *description = CheatDatabase::next(cheat);
+    const char *code = CheatDatabase::next(cheat);
 
-      auto item = new QTreeWidgetItem(list);
-      item->setCheckState(0, Qt::Unchecked);
-      item->setText(0, string() << description);
-      QString qcode = code;
-      item->setData(0, Qt::UserRole, QVariant(qcode));
-    }
+    auto item = new QTreeWidgetItem(list);
+    item->setCheckState(0, Qt::Unchecked);
+    item->setText(0, QString::fromUtf8(description));
+    item->setData(0, Qt::UserRole, QVariant(QString::fromUtf8(code)));
   }
 }
 
@@ -97,6 +97,9 @@ CheatFinderWindow::CheatFinderWindow() {
   resetButton = new QPushButton("Reset");
   actionLayout->addWidget(resetButton);
 
+  resultsLabel = new QLabel;
+  layout->addWidget(resultsLabel);
+
   connect(compareToPrev, SIGNAL(toggled(bool)), this, SLOT(toggle_editline(bool)));
   connect(compareToAddress, SIGNAL(toggled(bool)), this, SLOT(toggle_editline(bool)));
   connect(compareToValue, SIGNAL(toggled(bool)), this, SLOT(toggle_editline(bool)));
@@ -116,6 +119,8 @@ void CheatFinderWindow::synchronize() {
   if(SNES::cartridge.loaded() == false || application.power == false) {
     list->clear();
     for(unsigned n = 0; n < 3; n++) list->resizeColumnToContents(n);
+    engine.reset();
+    resultsLabel->setText("");
     searchButton->setEnabled(false);
     resetButton->setEnabled(false);
   } else {
@@ -133,16 +138,18 @@ void CheatFinderWindow::refreshList() {
   if(size24bit->isChecked()) size = 2;
   if(size32bit->isChecked()) size = 3;
 
-  for(unsigned i = 0; i < addrList.size() && i < 256; i++) {
+  engine.enumerate(ResultLimit, [&](unsigned r, unsigned offset) {
+    const CheatSearch::Region &region = engine.region(r);
     QTreeWidgetItem *item = new QTreeWidgetItem(list);
 
-    unsigned addr = addrList[i];
-    unsigned data = read(addr, size);
-    unsigned prev = dataList[i];
+    unsigned data = CheatSearch::read(region.current, region.size, offset, size + 1);
+    unsigned prev = CheatSearch::read(region.previous, region.size, offset, size + 1);
 
     char temp[256];
 
-    sprintf(temp, "%.6x", 0x7e0000 + addr);
+    if(*region.name == 0) sprintf(temp, "%.6x", region.base + offset);
+    else if(region.size <= 0x10000) sprintf(temp, "%s:%.4x", region.name, region.base + offset);
+    else sprintf(temp, "%s:%.6x", region.name, region.base + offset);
     item->setText(0, temp);
 
     sprintf(temp, "%u (0x%x)", data, data);
@@ -150,7 +157,12 @@ void CheatFinderWindow::refreshList() {
 
     sprintf(temp, "%u (0x%x)", prev, prev);
     item->setText(2, temp);
-  }
+  });
+
+  unsigned results = engine.results();
+  if(engine.started() == false) resultsLabel->setText("");
+  else if(results <= ResultLimit) resultsLabel->setText(string() << results << " matches");
+  else resultsLabel->setText(string() << results << " matches; showing the first " << (unsigned)ResultLimit);
 
   list->setSortingEnabled(true);
   list->header()->setSortIndicatorShown(false);
@@ -163,7 +175,7 @@ void CheatFinderWindow::searchMemory() {
   if(size24bit->isChecked()) size = 2;
   if(size32bit->isChecked()) size = 3;
 
-  unsigned data;
+  unsigned data = 0;
   if(!compareToPrev->isChecked()){
     string text = valueEdit->text().toUtf8().constData();
 
@@ -176,60 +188,32 @@ void CheatFinderWindow::searchMemory() {
     if(compareToAddress->isChecked()){
       //How should incorrect addresses be handled? For now we wrap around.
       data %= SNES::memory::wram.size();
-      data = read(data, size);
+      data = CheatSearch::read(SNES::memory::wram.data(), SNES::memory::wram.size(), data, size + 1);
     }
   }
 
-  if(addrList.size() == 0) {
-    //search for the first time: enqueue all possible values so they are all searched
-    for(unsigned addr = 0; addr < SNES::memory::wram.size(); addr++) {
-      addrList.append(addr);
-      dataList.append(read(addr, size));
+  if(engine.regions() == 0) {
+    //search for the first time: snapshot every RAM the game can keep values in
+    engine.attach("", 0x7e0000, SNES::memory::wram.data(), SNES::memory::wram.size());
+    if(SNES::cartridge.has_sa1()) {
+      engine.attach("", 0x003000, SNES::memory::iram.data(), SNES::memory::iram.size());
+      engine.attach("", 0x400000, SNES::memory::cartram.data(), SNES::memory::cartram.size());
+    } else {
+      engine.attach("SRAM", 0, SNES::memory::cartram.data(), SNES::memory::cartram.size());
     }
+    engine.attach("APU", 0, SNES::memory::apuram.data(), SNES::memory::apuram.size());
   }
 
-  array<unsigned> newAddrList, newDataList, oldDataList;
-
-  for(unsigned i = 0; i < addrList.size(); i++) {
-    unsigned thisAddr = addrList[i];
-    unsigned thisData = read(thisAddr, size);
-
-    if(compareToPrev->isChecked()) data = dataList[i];
-
-    if((compareEqual->isChecked()       && thisData == data)
-    || (compareNotEqual->isChecked()    && thisData != data)
-    || (compareLessThan->isChecked()    && thisData <  data)
-    || (compareGreaterThan->isChecked() && thisData >  data)
-    ) {
-      newAddrList.append(thisAddr);
-      newDataList.append(thisData);
-      oldDataList.append(dataList[i]);
-    }
-  }
+  CheatSearch::Compare compare = CheatSearch::Compare::Equal;
+  if(compareNotEqual->isChecked()) compare = CheatSearch::Compare::NotEqual;
+  if(compareLessThan->isChecked()) compare = CheatSearch::Compare::LessThan;
+  if(compareGreaterThan->isChecked()) compare = CheatSearch::Compare::GreaterThan;
 
-  //first refresh the list with the old data values (for the previous value column)
-  addrList = newAddrList;
-  dataList = oldDataList;
+  engine.search(size + 1, compare, compareToPrev->isChecked(), data);
   refreshList();
-
-  //and now update the list with the new data values (for the next search)
-  dataList = newDataList;
 }
 
 void CheatFinderWindow::resetSearch() {
-  addrList.reset();
-  dataList.reset();
+  engine.reset();
   refreshList();
 }
-
-//size = 0 (8-bit), 1 (16-bit), 2 (24-bit), 3 (32-bit)
-unsigned CheatFinderWindow::read(unsigned addr, unsigned size) {
-  unsigned data = 0;
-
-  for(unsigned n = 0; n <= size; n++) {
-    if(addr + n >= SNES::memory::wram.size()) break;
-    data |= SNES::memory::wram[addr + n] << (n << 3);
-  }
-
-  return data;
-}
@@ -22,6 +22,7 @@ public:
   QLineEdit *valueEdit;
   QPushButton *searchButton;
   QPushButton *resetButton;
+  QLabel *resultsLabel;
 
   QButtonGroup *compareToGroup;
   QLabel *compareToLabel;
@@ -39,10 +40,9 @@ public slots:
   void resetSearch();
 
 private:
-  array<unsigned> addrList;
-  array<unsigned> dataList;
+  enum : unsigned { ResultLimit = 1024 };  //matches listed; the search itself is unbounded
 
-  unsigned read(unsigned addr, unsigned size);
+  CheatSearch engine;
 };
 
 extern CheatFinderWindow *cheatFinderWindow;
@@ -0,0 +1,136 @@
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+
+void CheatSearch::reset() {
+  for(unsigned r = 0; r < list.size(); r++) {
+    delete[] list[r].current;
+    delete[] list[r].previous;
+    delete[] list[r].candidates;
+  }
+  list.reset();
+  searched = false;
+}
+
+//regions must be attached before the first search; source must stay valid until reset()
+void CheatSearch::attach(const char *name, unsigned base, const uint8_t *source, unsigned size) {
+  if(size == 0) return;
+  Region region;
+  region.name = name;
+  region.base = base;
+  region.source = source;
+  region.size = size;
+  region.current = new uint8_t[size + Padding]();
+  region.previous = new uint8_t[size + Padding]();
+
+  unsigned words = (size + 63) >> 6;
+  region.candidates = new uint64_t[words];
+  for(unsigned w = 0; w < words; w++) region.candidates[w] = ~0ull;
+  if(size & 63) region.candidates[words - 1] = (1ull << (size & 63)) - 1;
+  list.append(region);
+}
+
+bool CheatSearch::started() const { return searched; }
+unsigned CheatSearch::regions() const { return list.size(); }
+const CheatSearch::Region& CheatSearch::region(unsigned n) const { return list[n]; }
+
+void CheatSearch::search(unsigned width, Compare compare, bool previous, uint32_t value) {
+  width = max(1u, min(4u, width));
+  for(unsigned r = 0; r < list.size(); r++) {
+    Region &region = list[r];
+    if(searched) {
+      swap(region.current, region.previous);
+      memcpy(region.current, region.source, region.size);
+    } else {
+      //the first search has no earlier snapshot; compare each address to itself
+      memcpy(region.current, region.source, region.size);
+      memcpy(region.previous, region.source, region.size);
+    }
+    filter(region, width, compare, previous, value);
+  }
+  searched = true;
+}
+
+unsigned CheatSearch::results() const {
+  unsigned count = 0;
+  for(unsigned r = 0; r < list.size(); r++) {
+    for(unsigned w = 0; w < (list[r].size + 63) >> 6; w++) count += __builtin_popcountll(list[r].candidates[w]);
+  }
+  return count;
+}
+
+//little-endian value of width bytes at offset; bytes past the end of the region read as zero
+uint32_t CheatSearch::read(const uint8_t *data, unsigned size, unsigned offset, unsigned width) {
+  uint32_t result = 0;
+  for(unsigned n = 0; n < width && offset + n < size; n++) result |= data[offset + n] << (n << 3);
+  return result;
+}
+
+//multi-byte compares are built from per-byte results, most significant byte last:
+//equal = all bytes equal; less = less at byte k, or equal at byte k and less below it
+void CheatSearch::filter(Region &region, unsigned width, Compare compare, bool previous, uint32_t value) {
+  unsigned words = (region.size + 63) >> 6;
+
+  if(!previous && width < 4 && value >> (width << 3)) {
+    //value does not fit in width bytes: every address compares less than it
+    if(compare == Compare::Equal || compare == Compare::GreaterThan) {
+      for(unsigned w = 0; w < words; w++) region.candidates[w] = 0;
+    }
+    return;
+  }
+
+  #if defined(__SSE2__)
+  const __m128i bias = _mm_set1_epi8(0x80);
+  __m128i operand[4];
+  for(unsigned k = 0; k < width; k++) operand[k] = _mm_set1_epi8(value >> (k << 3));
+
+  for(unsigned w = 0; w < words; w++) {
+    if(region.candidates[w] == 0) continue;
+    uint64_t mask = 0;
+    for(unsigned part = 0; part < 4; part++) {
+      unsigned offset = (w << 6) + (part << 4);
+      __m128i result;
+      for(unsigned k = 0; k < width; k++) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(region.current + offset + k));
+        __m128i b = previous ? _mm_loadu_si128((const __m128i*)(region.previous + offset + k)) : operand[k];
+        __m128i eq = _mm_cmpeq_epi8(a, b);
+        if(compare == Compare::Equal || compare == Compare::NotEqual) {
+          result = k == 0 ? eq : _mm_and_si128(result, eq);
+        } else {
+          a = _mm_xor_si128(a, bias);
+          b = _mm_xor_si128(b, bias);
+          __m128i order = compare == Compare::LessThan ? _mm_cmplt_epi8(a, b) : _mm_cmpgt_epi8(a, b);
+          result = k == 0 ? order : _mm_or_si128(order, _mm_and_si128(eq, result));
+        }
+      }
+      mask |= (uint64_t)(uint16_t)_mm_movemask_epi8(result) << (part << 4);
+    }
+    if(compare == Compare::NotEqual) mask = ~mask;
+    region.candidates[w] &= mask;
+  }
+  #else
+  for(unsigned w = 0; w < words; w++) {
+    for(uint64_t bits = region.candidates[w]; bits; bits &= bits - 1) {
+      unsigned offset = (w << 6) + __builtin_ctzll(bits);
+      uint32_t data = read(region.current, region.size, offset, width);
+      uint32_t operand = previous ? read(region.previous, region.size, offset, width) : value;
+      bool match = false;
+      switch(compare) {
+        case Compare::Equal:       match = data == operand; break;
+        case Compare::NotEqual:    match = data != operand; break;
+        case Compare::LessThan:    match = data <  operand; break;
+        case Compare::GreaterThan: match = data >  operand; break;
+      }
+      if(!match) region.candidates[w] &= ~(1ull << (offset & 63));
+    }
+  }
+  #endif
+}
+
+CheatSearch::CheatSearch() {
+  searched = false;
+}
+
+CheatSearch::~CheatSearch() {
+  reset();
+}
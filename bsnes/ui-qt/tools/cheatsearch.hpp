@@ -0,0 +1,54 @@
+//RAM search engine behind the cheat finder.
+//each region is snapshotted into a flat buffer per search; candidates are kept as one bit per address,
+//and compares test sixteen addresses at a time, byte by byte, so every value width shares one kernel.
+class CheatSearch {
+public:
+  enum class Compare : unsigned { Equal, NotEqual, LessThan, GreaterThan };
+
+  struct Region {
+    const char *name;
+    unsigned base;         //address shown for offset 0
+    const uint8_t *source;
+    unsigned size;
+    uint8_t *current;      //snapshot taken by the last search
+    uint8_t *previous;     //snapshot taken by the search before it
+    uint64_t *candidates;  //bit n set = offset n still matches
+  };
+
+  void reset();
+  void attach(const char *name, unsigned base, const uint8_t *source, unsigned size);
+  bool started() const;
+  unsigned regions() const;
+  const Region& region(unsigned n) const;
+
+  //width = 1-4 bytes; compares against value, or against each address' own previous value when previous = true
+  void search(unsigned width, Compare compare, bool previous, uint32_t value);
+  unsigned results() const;
+  //visits matches in address order, stopping after limit; callback(region, offset)
+  template<typename T> void enumerate(unsigned limit, const T &callback) const;
+
+  static uint32_t read(const uint8_t *data, unsigned size, unsigned offset, unsigned width);
+
+  CheatSearch();
+  ~CheatSearch();
+
+private:
+  enum : unsigned { Padding = 80 };  //snapshots are zero-padded so kernels may read past the last address
+
+  void filter(Region &region, unsigned width, Compare compare, bool previous, uint32_t value);
+
+  array<Region> list;
+  bool searched;
+};
+
+template<typename T> void CheatSearch::enumerate(unsigned limit, const T &callback) const {
+  for(unsigned r = 0; r < list.size(); r++) {
+    const Region &region = list[r];
+    for(unsigned w = 0; w < (region.size + 63) >> 6; w++) {
+      for(uint64_t bits = region.candidates[w]; bits; bits &= bits - 1) {
+        if(limit-- == 0) return;
+        callback(r, (w << 6) + __builtin_ctzll(bits));
+      }
+    }
+  }
+}
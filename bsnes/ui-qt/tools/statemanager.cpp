@@ -7,6 +7,9 @@ StateManagerWindow::StateManagerWindow() {
   layout->setSpacing(Style::WidgetSpacing);
   setLayout(layout);
 
+  listLayout = new QHBoxLayout;
+  layout->addLayout(listLayout);
+
   list = new QTreeWidget;
   list->setColumnCount(2);
   list->setHeaderLabels(QStringList() << "Slot" << "Description");
@@ -14,7 +17,11 @@ StateManagerWindow::StateManagerWindow() {
   list->sortByColumn(0, Qt::AscendingOrder);
   list->setRootIsDecorated(false);
   list->resizeColumnToContents(0);
-  layout->addWidget(list);
+  listLayout->addWidget(list);
+
+  thumbnail = new QLabel;
+  thumbnail->setFixedSize(StateFile::ThumbnailWidth, StateFile::ThumbnailHeight);
+  listLayout->addWidget(thumbnail, 0, Qt::AlignTop);
 
   infoLayout = new QHBoxLayout;
   layout->addLayout(infoLayout);
@@ -43,15 +50,23 @@ StateManagerWindow::StateManagerWindow() {
 
   connect(list, SIGNAL(itemSelectionChanged()), this, SLOT(synchronize()));
   connect(list, SIGNAL(itemActivated(QTreeWidgetItem*, int)), this, SLOT(loadAction()));
-  connect(descriptionText, SIGNAL(textEdited(const QString&)), this, SLOT(writeDescription()));
+  connect(descriptionText, SIGNAL(editingFinished()), this, SLOT(commitDescription()));
   connect(loadButton, SIGNAL(released()), this, SLOT(loadAction()));
   connect(saveButton, SIGNAL(released()), this, SLOT(saveAction()));
   connect(eraseButton, SIGNAL(released()), this, SLOT(eraseAction()));
 
+  for(unsigned n = 0; n < StateCount; n++) {
+    slotData[n] = 0;
+    slotSize[n] = 0;
+    slotHeader[n] = 0;
+  }
+
   synchronize();
 }
 
 void StateManagerWindow::reload() {
+  commitDescription();
+  readArchive();
   list->clear();
   list->setSortingEnabled(false);
 
@@ -98,11 +113,13 @@ void StateManagerWindow::synchronize() {
     unsigned n = item->data(0, Qt::UserRole).toUInt();
 
     if(isStateValid(n)) {
+      thumbnail->setPixmap(QPixmap::fromImage(slotHeader[n]->thumbnailImage()));
       descriptionText->setText(getStateDescription(n));
       descriptionText->setEnabled(true);
       loadButton->setEnabled(true);
       eraseButton->setEnabled(true);
     } else {
+      thumbnail->clear();
       descriptionText->setText("");
       descriptionText->setEnabled(false);
       loadButton->setEnabled(false);
@@ -110,6 +127,7 @@ void StateManagerWindow::synchronize() {
     }
     saveButton->setEnabled(true);
   } else {
+    thumbnail->clear();
     descriptionText->setText("");
     descriptionText->setEnabled(false);
     loadButton->setEnabled(false);
@@ -118,12 +136,14 @@ void StateManagerWindow::synchronize() {
   }
 }
 
-void StateManagerWindow::writeDescription() {
+//connected to editingFinished, so the archive is rewritten once per edit rather than per keystroke
+void StateManagerWindow::commitDescription() {
   QList<QTreeWidgetItem*> items = list->selectedItems();
   if(items.count() > 0) {
     QTreeWidgetItem *item = items[0];
     unsigned n = item->data(0, Qt::UserRole).toUInt();
     string description = descriptionText->text().toUtf8().constData();
+    if(isStateValid(n) == false || description == getStateDescription(n)) return;
     setStateDescription(n, description);
     update();
   }
@@ -143,8 +163,9 @@ void StateManagerWindow::saveAction() {
   if(items.count() > 0) {
     QTreeWidgetItem *item = items[0];
     unsigned n = item->data(0, Qt::UserRole).toUInt();
-    saveState(n);
-    writeDescription();
+    string description = descriptionText->text().toUtf8().constData();
+    saveState(n, description);
+    update();
     synchronize();
     descriptionText->setFocus();
   }
@@ -161,6 +182,88 @@ void StateManagerWindow::eraseAction() {
   }
 }
 
+void StateManagerWindow::setSlot(unsigned slot, uint8_t *data, unsigned size) {
+  delete[] slotData[slot];
+  delete slotHeader[slot];
+  slotData[slot] = data;
+  slotSize[slot] = size;
+  slotHeader[slot] = 0;
+  if(data == 0) return;
+
+  slotHeader[slot] = new StateFile;
+  if(slotHeader[slot]->decode(data, size, false) == false) {
+    delete slotHeader[slot];
+    slotHeader[slot] = 0;
+  }
+}
+
+void StateManagerWindow::readArchive() {
+  ::state.finishWrite();
+  for(unsigned n = 0; n < StateCount; n++) setSlot(n, 0, 0);
+  if(SNES::cartridge.loaded() == false) return;
+
+  file fp;
+  if(fp.open(filename(), file::mode::read) == false) return;
+  unsigned size = fp.size();
+
+  if(size >= 8 && fp.readl(4) == ArchiveSignature) {
+    unsigned count = min((unsigned)fp.readl(4), (unsigned)StateCount);
+    unsigned length[StateCount];
+    for(unsigned n = 0; n < count; n++) length[n] = fp.readl(4);
+    for(unsigned n = 0; n < count; n++) {
+      if(length[n] == 0) continue;
+      if(fp.offset() + length[n] > size) break;
+      uint8_t *data = new uint8_t[length[n]];
+      fp.read(data, length[n]);
+      setSlot(n, data, length[n]);
+    }
+    fp.close();
+    return;
+  }
+
+  //archives written by earlier versions hold raw serializer images in fixed-size slots;
+  //they are converted to the compressed container and written back on the next change
+  unsigned stateSize = SNES::system.serialize_size();
+  uint8_t *buffer = new uint8_t[stateSize];
+  for(unsigned n = 0; n < StateCount && (n + 1) * stateSize <= size; n++) {
+    fp.seek(n * stateSize);
+    fp.read(buffer, stateSize);
+    StateFile state;
+    if(state.decode(buffer, stateSize) == false || state.valid() == false) continue;
+    uint8_t *data;
+    unsigned length;
+    state.encode(data, length);
+    setSlot(n, data, length);
+  }
+  delete[] buffer;
+  fp.close();
+}
+
+void StateManagerWindow::writeArchive() {
+  string name = filename();
+  ::state.write([this, name] { return saveArchive(name); }, "", "Failed to save state archive.");
+}
+
+//runs on the state writer thread
+bool StateManagerWindow::saveArchive(const string &filename) {
+  unsigned count = 0;
+  for(unsigned n = 0; n < StateCount; n++) if(slotData[n]) count = n + 1;
+  if(count == 0) {
+    //no states used, remove empty file
+    unlink(filename);
+    return true;
+  }
+
+  file fp;
+  if(fp.open(filename, file::mode::write) == false) return false;
+  fp.writel(ArchiveSignature, 4);
+  fp.writel(count, 4);
+  for(unsigned n = 0; n < count; n++) fp.writel(slotSize[n], 4);
+  for(unsigned n = 0; n < count; n++) fp.write(slotData[n], slotSize[n]);
+  fp.close();
+  return true;
+}
+
 string StateManagerWindow::filename() const {
   string name = filepath(nall::basename(cartridge.fileName), config().path.state);
   name << ".bsa";
@@ -169,116 +272,60 @@ string StateManagerWindow::filename() const {
 
 bool StateManagerWindow::isStateValid(unsigned slot) {
   if(SNES::cartridge.loaded() == false) return false;
-  file fp;
-  if(fp.open(filename(), file::mode::read) == false) return false;
-  if(fp.size() < (slot + 1) * SNES::system.serialize_size()) { fp.close(); return false; }
-  fp.seek(slot * SNES::system.serialize_size());
-  uint32_t signature = fp.readl(4);
-  if(signature != SNES::Info::SerializerSignature) { fp.close(); return false; }
-  uint32_t version = fp.readl(4);
-  if(version != SNES::Info::SerializerVersion) { fp.close(); return false; }
-  fp.readl(4);  //skip CRC32
-  char profile[16];
-  fp.read((uint8_t*)profile, 16);
-  if(strcmp(profile, SNES::Info::Profile)) { fp.close(); return false; }
-  fp.close();
-  return true;
+  return slotHeader[slot] && slotHeader[slot]->valid();
 }
 
 string StateManagerWindow::getStateDescription(unsigned slot) {
   if(isStateValid(slot) == false) return "";
-  file fp;
-  fp.open(filename(), file::mode::read);
-  char description[512];
-  fp.seek(slot * SNES::system.serialize_size() + 28);
-  fp.read((uint8_t*)description, 512);
-  fp.close();
-  description[511] = 0;
-  return description;
+  return slotHeader[slot]->description;
 }
 
 void StateManagerWindow::setStateDescription(unsigned slot, const string &text) {
   if(isStateValid(slot) == false) return;
-  file fp;
-  fp.open(filename(), file::mode::readwrite);
-  char description[512];
-  memset(&description, 0, sizeof description);
-  strncpy(description, text, 512);
-  fp.seek(slot * SNES::system.serialize_size() + 28);
-  fp.write((uint8_t*)description, 512);
-  fp.close();
+  ::state.finishWrite();
+  uint8_t *data;
+  unsigned size;
+  if(StateFile::replaceDescription(slotData[slot], slotSize[slot], text, data, size) == false) return;
+  delete[] slotData[slot];
+  slotData[slot] = data;
+  slotSize[slot] = size;
+  slotHeader[slot]->description = text;
+  writeArchive();
 }
 
 void StateManagerWindow::loadState(unsigned slot) {
   if(isStateValid(slot) == false) return;
-  file fp;
-  fp.open(filename(), file::mode::read);
-  fp.seek(slot * SNES::system.serialize_size());
-  unsigned size = SNES::system.serialize_size();
-  uint8_t *data = new uint8_t[size];
-  fp.read(data, size);
-  fp.close();
+  ::state.finishWrite();
+  StateFile state;
+  if(state.decode(slotData[slot], slotSize[slot]) == false) return;
 
-  serializer state(data, size);
-  delete[] data;
-
-  if(SNES::system.unserialize(state) == true) {
+  if(SNES::system.unserialize(state.state) == true) {
     //toolsWindow->close();
   }
 }
 
-void StateManagerWindow::saveState(unsigned slot) {
-  file fp;
-  if(file::exists(filename()) == false) {
-    //try and create the file, bail out on failure (eg read-only device)
-    if(fp.open(filename(), file::mode::write) == false) return;
-    fp.close();
-  }
-
-  SNES::system.runtosave();
-  serializer state = SNES::system.serialize();
-
-  fp.open(filename(), file::mode::readwrite);
-
-  //user may save to slot #2 when slot #1 is empty; pad file to current slot if needed
-  unsigned stateOffset = SNES::system.serialize_size() * slot;
-  fp.seek(fp.size());
-  while(fp.size() < stateOffset) fp.write(0x00);
-
-  fp.seek(stateOffset);
-  fp.write(state.data(), state.size());
-  fp.close();
+void StateManagerWindow::saveState(unsigned slot, const string &description) {
+  ::state.finishWrite();
+  StateFile *state = new StateFile;
+  state->capture();
+  state->description = description;
+
+  //the listing only needs the header; the writer thread compresses the state into the slot
+  setSlot(slot, 0, 0);
+  slotHeader[slot] = new StateFile(*state);
+  slotHeader[slot]->state = serializer();
+
+  string name = filename();
+  ::state.write([this, state, slot, name] {
+    state->encode(slotData[slot], slotSize[slot]);
+    delete state;
+    return saveArchive(name);
+  }, "", "Failed to save state archive.");
 }
 
 void StateManagerWindow::eraseState(unsigned slot) {
   if(isStateValid(slot) == false) return;
-  file fp;
-  fp.open(filename(), file::mode::readwrite);
-  unsigned size = SNES::system.serialize_size();
-  fp.seek(slot * size);
-  for(unsigned i = 0; i < size; i++) fp.write(0x00);
-  fp.close();
-
-  //shrink state archive as much as possible:
-  //eg if only slot #2 and slot #31 were valid, but slot #31 was erased,
-  //file can be resized to only hold blank slot #1 + valid slot #2
-  signed lastValidState = -1;
-  for(signed i = StateCount - 1; i >= 0; i--) {
-    if(isStateValid(i)) {
-      lastValidState = i;
-      break;
-    }
-  }
-
-  if(lastValidState == -1) {
-    //no states used, remove empty file
-    unlink(filename());
-  } else {
-    unsigned neededFileSize = (lastValidState + 1) * SNES::system.serialize_size();
-    file fp;
-    if(fp.open(filename(), file::mode::readwrite)) {
-      if(fp.size() > neededFileSize) fp.truncate(neededFileSize);
-      fp.close();
-    }
-  }
+  ::state.finishWrite();
+  setSlot(slot, 0, 0);
+  writeArchive();
 }
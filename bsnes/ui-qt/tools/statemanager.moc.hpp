@@ -5,7 +5,9 @@ public:
   enum { StateCount = 32 };
 
   QVBoxLayout *layout;
+  QHBoxLayout *listLayout;
   QTreeWidget *list;
+  QLabel *thumbnail;
   QHBoxLayout *infoLayout;
   QLabel *descriptionLabel;
   QLineEdit *descriptionText;
@@ -22,18 +24,31 @@ public:
 
 public slots:
   void synchronize();
-  void writeDescription();
+  void commitDescription();
   void loadAction();
   void saveAction();
   void eraseAction();
 
 private:
+  //the whole archive is kept in memory as encoded StateFile blobs, and rewritten on change.
+  //slot saves and archive writes run on the state writer thread, which also fills in
+  //slotData for a new save; state.finishWrite() must return before slotData is touched
+  enum : unsigned { ArchiveSignature = 0x41535342 };  //'BSSA'
+  uint8_t *slotData[StateCount];
+  unsigned slotSize[StateCount];
+  StateFile *slotHeader[StateCount];  //decoded without the system state
+
+  void setSlot(unsigned slot, uint8_t *data, unsigned size);
+  void readArchive();
+  void writeArchive();
+  bool saveArchive(const string &filename);
+
   string filename() const;
   bool isStateValid(unsigned slot);
   string getStateDescription(unsigned slot);
   void setStateDescription(unsigned slot, const string&);
   void loadState(unsigned slot);
-  void saveState(unsigned slot);
+  void saveState(unsigned slot, const string &description);
   void eraseState(unsigned slot);
 };
 
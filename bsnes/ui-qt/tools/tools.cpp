@@ -3,7 +3,9 @@
 #include "tools.moc"
 ToolsWindow *toolsWindow;
 
+#include "cheatdatabase.cpp"
 #include "cheateditor.cpp"
+#include "cheatsearch.cpp"
 #include "cheatfinder.cpp"
 #include "statemanager.cpp"
 #include "effecttoggle.cpp"
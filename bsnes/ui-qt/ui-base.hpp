@@ -13,7 +13,10 @@
 
 #include <nall/base64.hpp>
 #include <nall/config.hpp>
+#include <nall/filemap.hpp>
 #include <nall/input.hpp>
+#include <nall/lz4.hpp>
+#include <nall/sha256.hpp>
 #include <nall/ups.hpp>
 #include <nall/snes/cartridge.hpp>
 #include <nall/qt/concept.hpp>
@@ -30,6 +33,7 @@ using namespace ruby;
 #include "interface.hpp"
 
 #include "application/application.moc.hpp"
+#include "application/pacer.hpp"
 
 #include "base/about.moc.hpp"
 #include "base/filebrowser.moc.hpp"
@@ -39,6 +43,7 @@ using namespace ruby;
 #include "base/stateselect.moc.hpp"
 
 #include "cartridge/cartridge.hpp"
+#include "cartridge/index.moc.hpp"
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.moc.hpp"
@@ -87,7 +92,9 @@ using namespace ruby;
 #include "state/state.hpp"
 
 #include "tools/tools.moc.hpp"
+#include "tools/cheatdatabase.hpp"
 #include "tools/cheateditor.moc.hpp"
+#include "tools/cheatsearch.hpp"
 #include "tools/cheatfinder.moc.hpp"
 #include "tools/statemanager.moc.hpp"
 #include "tools/effecttoggle.moc.hpp"
@@ -34,6 +34,9 @@ void Utility::updateSystemState() {
     interface.framesUpdated = false;
     text << interface.framesExecuted;
     text << " fps";
+    if(pacer.active) {
+      text << ", jitter " << (unsigned)(pacer.jitterAverage / 1000) << " / " << (unsigned)(pacer.jitterPeak / 1000) << " us";
+    }
   } else {
     //nothing to update
     return;
@@ -107,6 +110,7 @@ void Utility::updateEmulationSpeed(unsigned speed) {
 
   audio.set(Audio::Resample, true);  //always resample (required for volume adjust + frequency scaler)
   audio.set(Audio::ResampleRatio, (double)infreq / (double)outfreq);
+  pacer.setRate(infreq);
 }
 
 void Utility::updateControllers() {
@@ -0,0 +1,136 @@
+#ifndef NALL_LZ4_HPP
+#define NALL_LZ4_HPP
+
+#include <string.h>
+#include <nall/stdint.hpp>
+
+//LZ4 block format (no frame header): a sequence of tokens, each followed by literals and a back-reference.
+//the encoder uses a single-probe hash table, trading some ratio for throughput;
+//the decoder validates every length and offset, so corrupt input fails instead of overrunning buffers.
+
+namespace nall {
+  class lz4 {
+  public:
+    //worst-case encoded size for incompressible input
+    static unsigned bound(unsigned length) {
+      return length + length / 255 + 16;
+    }
+
+    //output must hold at least bound(length) bytes; returns encoded length
+    static unsigned encode(uint8_t *output, const uint8_t *input, unsigned length) {
+      enum : unsigned { HashBits = 14, MinMatch = 4, LastLiterals = 5, MatchLimit = 12 };
+      uint32_t *table = new uint32_t[1 << HashBits]();
+
+      uint8_t *op = output;
+      unsigned anchor = 0, i = 0;
+
+      if(length >= MatchLimit) {
+        unsigned limit = length - MatchLimit;
+        while(i < limit) {
+          uint32_t sequence = read32(input + i);
+          unsigned hash = (sequence * 2654435761u) >> (32 - HashBits);
+          unsigned candidate = table[hash];
+          table[hash] = i;
+
+          if(candidate >= i || i - candidate > 65535 || read32(input + candidate) != sequence) {
+            i++;
+            continue;
+          }
+
+          //extend match backward over pending literals
+          while(i > anchor && candidate > 0 && input[i - 1] == input[candidate - 1]) { i--; candidate--; }
+
+          unsigned matchLength = MinMatch;
+          unsigned matchEnd = length - LastLiterals;
+          while(i + matchLength < matchEnd && input[i + matchLength] == input[candidate + matchLength]) matchLength++;
+
+          op = sequenceWrite(op, input + anchor, i - anchor, i - candidate, matchLength - MinMatch);
+          i += matchLength;
+          anchor = i;
+        }
+      }
+
+      //final sequence: literals only
+      unsigned literals = length - anchor;
+      uint8_t *token = op++;
+      *token = (literals >= 15 ? 15 : literals) << 4;
+      if(literals >= 15) op = lengthWrite(op, literals - 15);
+      memcpy(op, input + anchor, literals);
+      op += literals;
+
+      delete[] table;
+      return op - output;
+    }
+
+    //decodes exactly length bytes into output; returns false on malformed input
+    static bool decode(uint8_t *output, unsigned length, const uint8_t *input, unsigned inlength) {
+      const uint8_t *ip = input, *ipend = input + inlength;
+      uint8_t *op = output, *opend = output + length;
+
+      while(ip < ipend) {
+        unsigned token = *ip++;
+
+        unsigned literals = token >> 4;
+        if(literals == 15 && !lengthRead(ip, ipend, literals)) return false;
+        if(literals > (unsigned)(ipend - ip) || literals > (unsigned)(opend - op)) return false;
+        memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+        if(ip == ipend) break;  //last sequence carries no match
+
+        if(ipend - ip < 2) return false;
+        unsigned offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if(offset == 0 || offset > (unsigned)(op - output)) return false;
+
+        unsigned matchLength = token & 15;
+        if(matchLength == 15 && !lengthRead(ip, ipend, matchLength)) return false;
+        matchLength += 4;
+        if(matchLength > (unsigned)(opend - op)) return false;
+
+        //byte copy: source and destination may overlap when offset < matchLength
+        const uint8_t *match = op - offset;
+        while(matchLength--) *op++ = *match++;
+      }
+
+      return op == opend;
+    }
+
+  private:
+    static uint32_t read32(const uint8_t *p) {
+      uint32_t data;
+      memcpy(&data, p, 4);
+      return data;
+    }
+
+    static uint8_t* lengthWrite(uint8_t *op, unsigned length) {
+      while(length >= 255) { *op++ = 255; length -= 255; }
+      *op++ = length;
+      return op;
+    }
+
+    static bool lengthRead(const uint8_t *&ip, const uint8_t *ipend, unsigned &length) {
+      unsigned byte;
+      do {
+        if(ip >= ipend) return false;
+        byte = *ip++;
+        length += byte;
+      } while(byte == 255);
+      return true;
+    }
+
+    static uint8_t* sequenceWrite(uint8_t *op, const uint8_t *literal, unsigned literals, unsigned offset, unsigned matchLength) {
+      uint8_t *token = op++;
+      *token = ((literals >= 15 ? 15 : literals) << 4) | (matchLength >= 15 ? 15 : matchLength);
+      if(literals >= 15) op = lengthWrite(op, literals - 15);
+      memcpy(op, literal, literals);
+      op += literals;
+      *op++ = offset;
+      *op++ = offset >> 8;
+      if(matchLength >= 15) op = lengthWrite(op, matchLength - 15);
+      return op;
+    }
+  };
+}
+
+#endif
@@ -1,8 +1,11 @@
 #ifndef NALL_SERIALIZER_HPP
 #define NALL_SERIALIZER_HPP
 
+#include <string.h>
 #include <type_traits>
 #include <utility>
+#include <nall/detect.hpp>
+#include <nall/endian.hpp>
 #include <nall/stdint.hpp>
 #include <nall/utility.hpp>
 
@@ -66,10 +69,32 @@ namespace nall {
 
     template<typename T> void array(T &array) {
       enum { size = sizeof(T) / sizeof(typename std::remove_extent<T>::type) };
-      for(unsigned n = 0; n < size; n++) integer(array[n]);
+      this->array(array, size);
     }
 
+    //arrays of plain integers are stored with one memcpy when the host byte order matches
+    //the little-endian stream format; bool and wrapper types still go through integer()
     template<typename T> void array(T array, unsigned size) {
+      typedef typename std::remove_reference<decltype(array[0])>::type element_t;
+      enum { boolean = std::is_same<bool, element_t>::value };
+      enum { width = boolean ? 1 : sizeof(element_t) };
+      if(imode == Size) {
+        isize += size * width;
+        return;
+      }
+
+      #if !defined(ARCH_MSB)
+      enum { bulk = std::is_integral<element_t>::value && !boolean };
+      #else
+      enum { bulk = std::is_integral<element_t>::value && !boolean && width == 1 };
+      #endif
+      if(bulk) {
+        if(imode == Save) memcpy(idata + isize, (const void*)&array[0], size * width);
+        else memcpy((void*)&array[0], idata + isize, size * width);
+        isize += size * width;
+        return;
+      }
+
       for(unsigned n = 0; n < size; n++) integer(array[n]);
     }
 
@@ -103,7 +128,7 @@ namespace nall {
       return *this;
     }
 
-    serializer(serializer &&s) {
+    serializer(serializer &&s) : idata(0) {
       operator=(std::move(s));
     }
 
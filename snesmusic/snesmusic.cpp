@@ -32,6 +32,7 @@ static struct {
 static const char *spc_header = "SNES-SPC700 Sound File Data v0.30\x1a\x1a";
 
 static void read_tag_id666(file &spc);
+static time_t parse_length(const char *text);
 static bool load_snsf_internal(nall::string &filename, uint8_t *&data, unsigned &size, int depth = 0);
 static const char* string_convert(const char *in, unsigned maxwidth);
 
@@ -49,6 +50,11 @@ bsnesexport bool snesmusic_loaded() {
 	return info.loaded;
 }
 
+// song length in seconds from the file's tags, or 0 if not tagged
+bsnesexport unsigned snesmusic_length() {
+	return info.loaded ? info.length : 0;
+}
+
 bsnesexport bool snesmusic_load_spc(string &filename, uint8_t *&dump,
                                     uint16_t &pc, uint8_t (&regs)[4], uint8_t &p) {
 
@@ -289,6 +295,8 @@ bool load_snsf_internal(nall::string &filename, uint8_t *&data, unsigned &size,
 		info.artist = tags["artist"];
 	if (tags.count("game"))
 		info.game = tags["game"];
+	if (tags.count("length"))
+		info.length = parse_length(tags["length"]);
 	
 	// load additional snsflibs
 	while (1) {
@@ -318,6 +326,20 @@ error_input:
 	return false;
 }
 
+// PSF tag lengths are [[h:]m:]s[.fraction]; the fraction is dropped
+time_t parse_length(const char *text) {
+	time_t length = 0, field = 0;
+	for (; *text && *text != '.'; text++) {
+		if (*text == ':') {
+			length = (length + field) * 60;
+			field = 0;
+		} else if (*text >= '0' && *text <= '9') {
+			field = field * 10 + (*text - '0');
+		}
+	}
+	return length + field;
+}
+
 /*
 	Terrible, lazy text drawing with the BitmapFont code borrowed/stolen from gambatte.
 	I'd like to clean up/expand this into a proper interface for drawing text (and more)
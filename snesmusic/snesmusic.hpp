@@ -5,6 +5,7 @@ extern "C" {
 	const char* snesmusic_supported();
 	void snesmusic_unload();
 	bool snesmusic_loaded();
+	unsigned snesmusic_length();
   
 	bool snesmusic_load_spc(nall::string &filename, uint8_t *&dump,
 	                        uint16_t &pc, uint8_t (&regs)[4], uint8_t &p);
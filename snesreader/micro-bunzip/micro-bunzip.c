@@ -57,9 +57,11 @@ typedef struct {
 	int in_fd,inbufCount,inbufPos;
 	unsigned char *inbuf;
 	unsigned int inbufBitCount, inbufBits;
-	/* Output buffer */
+	/* Output buffer, and an optional callback that receives it instead of out_fd */
 	char outbuf[IOBUF_SIZE];
 	int outbufPos;
+	void (*sink)(void *context, const char *data, int len);
+	void *sinkContext;
 	/* The CRC values stored in the block header and calculated from the data */
 	unsigned int crc32Table[256],headerCRC, dataCRC, totalCRC;
 	/* Intermediate buffer and its size (in bytes) */
@@ -358,7 +360,8 @@ extern int read_bunzip_data(bunzip_data *bd)
 extern void flush_bunzip_outbuf(bunzip_data *bd, int out_fd)
 {
 	if(bd->outbufPos) {
-		if(write(out_fd, bd->outbuf, bd->outbufPos) != bd->outbufPos)
+		if(bd->sink) bd->sink(bd->sinkContext, bd->outbuf, bd->outbufPos);
+		else if(write(out_fd, bd->outbuf, bd->outbufPos) != bd->outbufPos)
 			longjmp(bd->jmpbuf,RETVAL_UNEXPECTED_OUTPUT_EOF);
 		bd->outbufPos=0;
 	}
@@ -507,6 +510,27 @@ extern char *uncompressStream(int src_fd, int dst_fd)
 	return bunzip_errors[-i];
 }
 
+/* Decompress src_fd, handing the output to sink() in IOBUF_SIZE pieces
+   rather than writing it to a file. */
+extern char *uncompressStreamSink(int src_fd, void (*sink)(void *context, const char *data, int len), void *context)
+{
+	bunzip_data *bd;
+	int i;
+
+	if(!(i=start_bunzip(&bd,src_fd,0,0))) {
+		bd->sink=sink;
+		bd->sinkContext=context;
+		i=write_bunzip_data(bd,-1,0,0);
+		if(i==RETVAL_LAST_BLOCK && bd->headerCRC==bd->totalCRC) i=RETVAL_OK;
+		flush_bunzip_outbuf(bd,-1);
+	}
+	if(bd) {
+		if(bd->dbuf) free(bd->dbuf);
+		free(bd);
+	}
+	return bunzip_errors[-i];
+}
+
 /* Dumb little test thing, decompress stdin to stdout */
 /*int main(int argc, char *argv[])
 {
@@ -8,7 +8,7 @@
 
 #include "fex/fex.h"
 #include "libjma/jma.h"
-extern "C" char* uncompressStream(int, int);  //micro-bunzip
+extern "C" char* uncompressStreamSink(int, void (*)(void*, const char*, int), void*);  //micro-bunzip
 
 #define QT_CORE_LIB
 #include <QtGui>
@@ -33,6 +33,20 @@ bool snesreader_load_normal(const char *filename, uint8_t *&data, unsigned &size
 
 #include "filechooser.cpp"
 
+//only valid ROM extensions are offered from archives (ignore text files, save RAM files, etc)
+static bool snesreader_fex_image(const char *filename, const char *name) {
+  return striend(name, ".sfc") || striend(name, ".smc")
+  || striend(name, ".swc") || striend(name, ".fig")
+  || striend(name, ".bs")  || striend(name, ".st")
+  || striend(name, ".gb")  || striend(name, ".sgb") || striend(name, ".gbc")
+  || striend(filename, ".gz");  //GZip files only contain a single file
+}
+
+static bool snesreader_fex_type(const char *filename) {
+  return striend(filename, ".zip") || striend(filename, ".z")
+  || striend(filename, ".7z") || striend(filename, ".gz");
+}
+
 bool snesreader_load_fex(string &filename, uint8_t *&data, unsigned &size) {
   fex_t *fex;
   fex_open(&fex, filename);
@@ -44,13 +58,7 @@ bool snesreader_load_fex(string &filename, uint8_t *&data, unsigned &size) {
   while(fex_done(fex) == false) {
     fex_stat(fex);
     const char *name = fex_name(fex);
-    //only add valid ROM extensions to list (ignore text files, save RAM files, etc)
-    if(striend(name, ".sfc") || striend(name, ".smc")
-    || striend(name, ".swc") || striend(name, ".fig")
-    || striend(name, ".bs")  || striend(name, ".st")
-    || striend(name, ".gb")  || striend(name, ".sgb") || striend(name, ".gbc")
-    || striend(filename, ".gz")  //GZip files only contain a single file
-    ) {
+    if(snesreader_fex_image(filename, name)) {
       fileChooser->list[fileChooser->list.size()] = name;
     }
     fex_next(fex);
@@ -95,29 +103,55 @@ bool snesreader_load_fex(string &filename, uint8_t *&data, unsigned &size) {
   return false;
 }
 
-bool snesreader_load_bz2(const char *filename, uint8_t *&data, unsigned &size) {
-  //TODO: need a way to get the size of a bzip2 file, so we can pre-allocate
-  //a buffer to decompress into memory. for now, use a temporary file.
-
-  string name = "/tmp/.bz2_temporary_decompression_object";
-  FILE *wr;
-  wr = fopen_utf8(name, "wb");
-  if(!wr) {
-    //try the local directory
-    name = ".bz2_temporary_decompression_object";
-    wr = fopen_utf8(name, "wb");
-    //can't get write access, so give up
-    if(!wr) return false;
+//growable output buffer for decoders that do not know the decompressed size up front
+struct snesreader_buffer {
+  uint8_t *data;
+  unsigned size;
+  unsigned capacity;
+
+  static void append(void *context, const char *input, int length) {
+    snesreader_buffer &self = *(snesreader_buffer*)context;
+    if(self.size + length > self.capacity) {
+      unsigned capacity = self.capacity;
+      while(self.size + length > capacity) capacity <<= 1;
+      uint8_t *data = new uint8_t[capacity];
+      memcpy(data, self.data, self.size);
+      delete[] self.data;
+      self.data = data;
+      self.capacity = capacity;
+    }
+    memcpy(self.data + self.size, input, length);
+    self.size += length;
   }
+};
 
+bool snesreader_load_bz2(const char *filename, uint8_t *&data, unsigned &size) {
   FILE *fp = fopen_utf8(filename, "rb");
-  uncompressStream(fileno(fp), fileno(wr));
+  if(!fp) return false;
+
+  //bzip2 does not record the decompressed size; reserve a typical expansion of the
+  //compressed size up front, so most images decode straight into the final buffer
+  fseek(fp, 0, SEEK_END);
+  unsigned compressed = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+
+  snesreader_buffer buffer;
+  buffer.size = 0;
+  buffer.capacity = 1 << 20;
+  while(buffer.capacity < compressed * 4 && buffer.capacity < 1u << 28) buffer.capacity <<= 1;
+  buffer.data = new uint8_t[buffer.capacity];
+
+  bool success = !uncompressStreamSink(fileno(fp), &snesreader_buffer::append, &buffer) && buffer.size > 0;
   fclose(fp);
-  fclose(wr);
 
-  bool success = snesreader_load_normal(name, data, size);
-  unlink(name);
-  return success;
+  if(!success) {
+    delete[] buffer.data;
+    return false;
+  }
+
+  data = buffer.data;
+  size = buffer.size;
+  return true;
 }
 
 bool snesreader_load_jma(const char *filename, uint8_t *&data, unsigned &size) {
@@ -144,10 +178,7 @@ bsnesexport bool snesreader_load(string &filename, uint8_t *&data, unsigned &siz
   if(file::exists(filename) == false) return false;
 
   bool success = false;
-  if(striend(filename, ".zip")
-  || striend(filename, ".z")
-  || striend(filename, ".7z")
-  || striend(filename, ".gz")) {
+  if(snesreader_fex_type(filename)) {
     success = snesreader_load_fex(filename, data, size);
   } else if(striend(filename, ".bz2")) {
     success = snesreader_load_bz2(filename, data, size);
@@ -159,3 +190,53 @@ bsnesexport bool snesreader_load(string &filename, uint8_t *&data, unsigned &siz
 
   return success;
 }
+
+//lists the images contained in an archive; formats holding a single image report one empty name
+bsnesexport bool snesreader_list(const char *filename, lstring &names) {
+  names.reset();
+  if(file::exists(filename) == false) return false;
+
+  if(snesreader_fex_type(filename)) {
+    fex_t *fex;
+    if(fex_open(&fex, filename)) return false;
+    while(fex_done(fex) == false) {
+      fex_stat(fex);
+      if(snesreader_fex_image(filename, fex_name(fex))) names.append(fex_name(fex));
+      fex_next(fex);
+    }
+    fex_close(fex);
+  } else {
+    names.append("");
+  }
+
+  return names.size() > 0;
+}
+
+//loads one image listed by snesreader_list()
+bsnesexport bool snesreader_extract(const char *filename, const char *name, uint8_t *&data, unsigned &size) {
+  if(file::exists(filename) == false) return false;
+
+  if(snesreader_fex_type(filename) == false) {
+    if(striend(filename, ".bz2")) return snesreader_load_bz2(filename, data, size);
+    if(striend(filename, ".jma")) return snesreader_load_jma(filename, data, size);
+    return snesreader_load_normal(filename, data, size);
+  }
+
+  fex_t *fex;
+  if(fex_open(&fex, filename)) return false;
+  while(fex_done(fex) == false) {
+    fex_stat(fex);
+    if(!strcmp(name, fex_name(fex))) {
+      size = fex_size(fex);
+      data = new uint8_t[size];
+      bool success = !fex_read(fex, data, size);
+      fex_close(fex);
+      if(!success) delete[] data;
+      return success;
+    }
+    fex_next(fex);
+  }
+
+  fex_close(fex);
+  return false;
+}
@@ -1,7 +1,11 @@
 #include <stdint.h>
-namespace nall { class string; }
+namespace nall { class string; class lstring; }
 
 extern "C" {
   const char* snesreader_supported();
   bool snesreader_load(nall::string &filename, uint8_t *&data, unsigned &size);
+
+  //non-interactive access for background indexing: never opens a FileChooser
+  bool snesreader_list(const char *filename, nall::lstring &names);
+  bool snesreader_extract(const char *filename, const char *name, uint8_t *&data, unsigned &size);
 }
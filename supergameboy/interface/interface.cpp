@@ -111,6 +111,7 @@ bool SuperGameBoy::init(bool version_) {
 }
 
 void SuperGameBoy::term() {
+  state_size = 0;
   if(gambatte) {
     delete gambatte;
     gambatte = 0;
@@ -159,38 +160,29 @@ void SuperGameBoy::serialize(nall::serializer &s) {
   s.integer(bitdata);
   s.integer(bitoffset);
 
-  uint8_t *savestate = new uint8_t[256 * 1024];
-  if(s.mode() == serializer::Load) {
-    s.array(savestate, 256 * 1024);
-
-    file fp;
-    if(fp.open("supergameboy-state.tmp", file::mode::write)) {
-      fp.write(savestate, 256 * 1024);
-      fp.close();
-
-      gambatte->loadState("supergameboy-state.tmp");
-      unlink("supergameboy-state.tmp");
-    }
-  } else if(s.mode() == serializer::Save) {
-    gambatte->saveState("supergameboy-state.tmp");
-
-    file fp;
-    if(fp.open("supergameboy-state.tmp", file::mode::read)) {
-      fp.read(savestate, fp.size() < 256 * 1024 ? fp.size() : 256 * 1024);
-      fp.close();
-    }
+  //the gambatte state is a fixed size for a given cartridge, so it is stored inline without a length
+  std::string state;
+  if(s.mode() == serializer::Save && state_size) {
+    std::ostringstream stream;
+    gambatte->saveState(stream);
+    state = stream.str();
+  }
+  state.resize(state_size);
+  s.array((uint8_t*)&state[0], state_size);
 
-    unlink("supergameboy-state.tmp");
-    s.array(savestate, 256 * 1024);
-  } else if(s.mode() == serializer::Size) {
-    s.array(savestate, 256 * 1024);
+  if(s.mode() == serializer::Load && state_size) {
+    std::istringstream stream(state);
+    gambatte->loadState(stream);
   }
-  delete[] savestate;
 }
 
 void SuperGameBoy::power() {
   gambatte->load(true);
   mmio_reset();
+
+  std::ostringstream stream;
+  gambatte->saveState(stream);
+  state_size = stream.str().size();
 }
 
 void SuperGameBoy::reset() {
@@ -366,6 +358,7 @@ const Gambatte::InputState& SuperGameBoy::operator()() {
 SuperGameBoy::SuperGameBoy() : gambatte(0), buffer(0) {
   romdata = ramdata = rtcdata = 0;
   romsize = ramsize = rtcsize = 0;
+  state_size = 0;
 }
 
 SuperGameBoy::~SuperGameBoy() {
@@ -44,6 +44,7 @@ public:
   uint8_t *romdata, *ramdata, *rtcdata;
   unsigned romsize,  ramsize,  rtcsize;
   bool version;
+  unsigned state_size;  //bytes of gambatte state in a save state; measured at power-on
 
   bool init(bool version);
   void term();
@@ -27,6 +27,7 @@ class CPU;
 #include "filterinfo.h"
 #include "int.h"
 #include <vector>
+#include <iosfwd>
 
 namespace Gambatte {
 class GB {
@@ -74,6 +75,8 @@ public:
 	void loadState();
 	void saveState(const char *filepath);
 	void loadState(const char *filepath);
+	void saveState(std::ostream &stream);
+	bool loadState(std::istream &stream);
 	void selectState(int n);
 	int currentState() const { return stateNo; }
 };
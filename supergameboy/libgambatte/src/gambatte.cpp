@@ -176,6 +176,26 @@ void GB::loadState(const char *const filepath) {
 	loadState(filepath, false);
 }
 
+void GB::saveState(std::ostream &stream) {
+	SaveState state;
+	z80->setStatePtrs(state);
+	z80->saveState(state);
+	StateSaver::saveState(state, stream, false);
+}
+
+bool GB::loadState(std::istream &stream) {
+	z80->saveSavedata();
+	
+	SaveState state;
+	z80->setStatePtrs(state);
+	
+	if (!StateSaver::loadState(state, stream))
+		return false;
+	
+	z80->loadState(state);
+	return true;
+}
+
 void GB::selectState(int n) {
 	n -= (n / 10) * 10;
 	stateNo = n < 0 ? n + 10 : n;
@@ -19,6 +19,8 @@
 #ifndef STATESAVER_H
 #define STATESAVER_H
 
+#include <iosfwd>
+
 class SaveState;
 
 class StateSaver {
@@ -32,6 +34,10 @@ public:
 	
 	static void saveState(const SaveState &state, const char *filename);
 	static bool loadState(SaveState &state, const char *filename);
+	
+	// Stream variants, for keeping states in memory. Without snapshot, no thumbnail is stored.
+	static void saveState(const SaveState &state, std::ostream &file, bool snapshot);
+	static bool loadState(SaveState &state, std::istream &file);
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <sstream>
 
 #include <nall/file.hpp>
 #include <nall/serializer.hpp>